@@ -13,8 +13,33 @@ extern const char* error_time_not_incremented;
 extern const char* error_invalid_index;
 extern const char* error_malloc_failed;
 extern const char* error_incorrect_rudder_angle;
+extern const char* error_thread_create_failed;
 
-void set_error_msg(char** p_error_msg, const char* msg);
-void clear_error_msg(char** p_error_msg);
+/**
+ * Set the error message of an object. Only the pointer is kept, and therefore msg 
+ * should be one of the messages above, a string literal, or a buffer that outlives 
+ * the object. The function does not allocate memory, and writes to the object only 
+ * if the message changes. 
+ */
+static inline void set_error_msg(const char* const* p_error_msg, const char* msg)
+{
+  if(*p_error_msg != msg)
+  {
+    *(const char**)p_error_msg = msg;
+  }
+}
+
+/**
+ * Clear the error message of an object. The function writes to the object only if it 
+ * has an error message, so that calls on an object without errors, such as a sea 
+ * surface shared between threads, only read it. 
+ */
+static inline void clear_error_msg(const char* const* p_error_msg)
+{
+  if(*p_error_msg)
+  {
+    *(const char**)p_error_msg = NULL;
+  }
+}
 
 #endif // ERRORS_H
\ No newline at end of file
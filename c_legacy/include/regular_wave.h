@@ -1,6 +1,7 @@
 #ifndef REGULAR_WAVE_H
 #define REGULAR_WAVE_H
 
+#include <stddef.h>
 #include "geometry.h"
 
 /**
@@ -9,7 +10,8 @@
  * function regular_wave_new(). This function allocates and initialises 
  * a block of memory on the stack, and therefore all calls to 
  * regular_wave_new() should be paired with a call to regular_wave_delete() 
- * to avoid memory leaks. 
+ * to avoid memory leaks. Several regular waves can instead be initialised 
+ * in one block of memory owned by the caller, using regular_wave_init().
  * 
  * All functions operating on an instance of a Regular_wave have a mechanism 
  * to notify of exceptions. All instances of Regular_wave have a member variable 
@@ -46,6 +48,33 @@ struct Regular_wave* regular_wave_new(double amplitude,
  */
 void regular_wave_delete(struct Regular_wave* regular_wave);
 
+/**
+ * Get the size of an instance of Regular_wave, to allocate a block of memory 
+ * holding several regular waves to be initialised with regular_wave_init().
+ * @return size in bytes of an instance of Regular_wave.
+ */
+size_t regular_wave_get_size();
+
+/**
+ * Initialise a regular wave in a block of memory owned by the caller. A regular 
+ * wave initialised this way must not be passed to regular_wave_delete(); its 
+ * memory is released along with the block.
+ * @param memory is a non-null pointer to at least regular_wave_get_size() bytes,
+ * aligned for a double.
+ * @param amplitude of the wave in meter.
+ * @param frequency of the wave in Hz.
+ * @param phase of the wave in radians. 
+ * @param direction of propagation of the wave in radians with respect to the
+ * geographic north. The angle measured is positive in the clockwise direction such that 
+ * the geographic east is at PI/2 radians to the north.
+ * @return pointer to initialised object if the operation was successful, else, returns a null pointer. 
+ */
+struct Regular_wave* regular_wave_init(void* memory,
+                                       double amplitude, 
+                                       double frequency, 
+                                       double phase_lag, 
+                                       double direction);
+
 /**
  * Returns error message related to the last function called for the instance of Regular_wave.
  * @return pointer to the error msg, if any, else returns a null pointer. 
@@ -82,6 +82,24 @@ double sea_surface_get_elevation(const struct Sea_surface* sea_surface,
                           union Coordinates_3D location, 
                           double time);
 
+/**
+ * Get sea surface elevation at each of the given locations for the given time. 
+ * Same as calling sea_surface_get_elevation() for each location, but faster for 
+ * many locations.
+ * @param locations is an array of size count_locations with coordinates in meter, 
+ * at which the elevation is to be computed.
+ * @param count_locations is the number of locations.
+ * @param time for which the elevation is to be computed. Time is measured in seconds 
+ * from start of simulation.
+ * @param elevations is an array of size count_locations, in which the wave elevation, 
+ * in meter, at each location is written.
+ */
+void sea_surface_get_elevations(const struct Sea_surface* sea_surface, 
+                                const union Coordinates_3D* locations, 
+                                int count_locations,
+                                double time,
+                                double* elevations);
+
 /**
  * Function to get the number of regular component waves in the spectrum.
  */ 
@@ -10,6 +10,11 @@
  * This function allocates and initialises a block of memory on the stack, and 
  * therefore all calls to simulation_new() should be paired with a call to simulation_delete() 
  * to avoid memory leaks. 
+ * 
+ * The asvs in a simulation are numbered in the order in which they were added, 
+ * starting from 0. The index of an asv does not change during the lifetime of the 
+ * simulation, and the functions that take the index of an asv do not need to search 
+ * the simulation for it, unlike their counterparts that take a pointer to the asv.
  */
 struct Simulation;
 struct Asv;
@@ -26,7 +31,8 @@ struct Simulation* simulation_new();
 void simulation_delete(struct Simulation* simulation);
 
 /**
- * Function to read the input file and set the ASV's input values. 
+ * Function to read the input file and set the ASV's input values. All ASVs 
+ * share one sea surface, created from wave_ht, wave_heading and rand_seed. 
  * @param file is the path to the input toml file with asv specs.  
  * @param wave_ht wave height in meter.
  * @param wave_heading in deg.
@@ -74,6 +80,14 @@ void simulation_set_controller(struct Simulation* simulation, double* gain_posit
  */
 void simulation_tune_controller(struct Simulation* simulation);
 
+/**
+ * Set the number of threads on which the asvs are simulated. The threads are created once 
+ * at the start of each run of the simulation. 
+ * @param count_threads is the number of threads, or 0 for the number of processors, which is the default.
+ * Use 1 to simulate on the calling thread alone.
+ */
+void simulation_set_count_threads(struct Simulation* simulation, int count_threads);
+
 /**
  * Simulate vehicle dynamics for each time step till the vehicle reaches the last waypoint.
  * The function writes the results of the simulation into a file in the given output directory.
@@ -99,29 +113,77 @@ int simulation_get_count_asvs(struct Simulation* simulation);
 
 /**
  * Function to get all asvs simulated.
- * @param asvs is the return array with pointers to the asvs simulated. The function assumes that 
- * the caller has allocated sufficient size for asvs to contain all the pointers to be placed in it.
+ * @param asvs is the return array with pointers to the asvs simulated, in the order of 
+ * their index. The function assumes that the caller has allocated sufficient size for 
+ * asvs to contain all the pointers to be placed in it.
  * @return the number of pointers placed into the argument asvs. 
  */
 int simulation_get_asvs(struct Simulation* simulation, struct Asv** asvs);
 
 /**
- * Get the current waypoint for an asv.
+ * Get the index of an asv in the simulation.
+ * @return the index, in the range [0, simulation_get_count_asvs()), or -1 if the asv 
+ * is not in the simulation.
+ */
+int simulation_get_asv_index(struct Simulation* simulation, struct Asv* asv);
+
+/**
+ * Get the current position of the cog of all asvs simulated.
+ * @param positions is the return array with the position of each asv, in the order of 
+ * their index. The function assumes that the caller has allocated sufficient size for 
+ * positions to contain the positions of all asvs.
+ * @return the number of positions placed into the argument positions. 
+ */
+int simulation_get_positions(struct Simulation* simulation, union Coordinates_3D* positions);
+
+/**
+ * Get the current waypoint of all asvs simulated. 
+ * @param waypoints is the return array with the current waypoint of each asv, in the order 
+ * of their index. The function assumes that the caller has allocated sufficient size for 
+ * waypoints to contain the waypoints of all asvs.
+ * @return the number of waypoints placed into the argument waypoints. 
+ */
+int simulation_get_current_waypoints(struct Simulation* simulation, union Coordinates_3D* waypoints);
+
+/**
+ * Get the current waypoint for the asv at the given index. Once the asv has reached 
+ * its final waypoint, the final waypoint is returned.
+ */
+union Coordinates_3D simulation_get_waypoint_by_index(struct Simulation* simulation, int asv_index);
+
+/**
+ * Get the number of waypoints for the asv at the given index.
+ */
+int simulation_get_count_waypoints_by_index(struct Simulation* simulation, int asv_index);
+
+/**
+ * Function to get all waypoints for the asv at the given index.
+ */
+union Coordinates_3D* simulation_get_waypoints_by_index(struct Simulation* simulation, int asv_index);
+
+/**
+ * Get the position of the asv at the given index, recorded in the buffer at given index.
+ */
+union Coordinates_3D simulation_get_asv_position_at_by_index(struct Simulation* simulation, int asv_index, int index);
+
+/**
+ * Get the current waypoint for an asv. Same as simulation_get_waypoint_by_index().
  */
 union Coordinates_3D simulation_get_waypoint(struct Simulation* simulation, struct Asv* asv);
 
 /**
- * Get the number of waypoints for the asv.
+ * Get the number of waypoints for the asv. Same as simulation_get_count_waypoints_by_index().
  */
 int simulation_get_count_waypoints(struct Simulation* simulation, struct Asv* asv);
 
 /**
- * Function to get all waypoints for an asv.
+ * Function to get all waypoints for an asv. Same as simulation_get_waypoints_by_index().
  */
 union Coordinates_3D* simulation_get_waypoints(struct Simulation* simulation, struct Asv* asv);
 
 /**
- * Get the position of the asv recorded in the buffer at given index.
+ * Get the position of the asv recorded in the buffer at given index. Same as 
+ * simulation_get_asv_position_at_by_index().
  */
 union Coordinates_3D simulation_get_asv_position_at(struct Simulation* simulation, struct Asv* asv, int index);
 
@@ -20,7 +20,7 @@ struct Thruster
   union Coordinates_3D position;    //!< Position of thrust vector in ASV's body-fixed frame.
   union Coordinates_3D orientation; //!< Orientation of the thrust vector in body-fixed frame.
   double thrust;    //!< Magnitude of thrust in Newton.
-  char* error_msg;  //!< Error message, if any.
+  const char* error_msg;  //!< Error message, if any.
 };
 
 /**
@@ -53,7 +53,7 @@ struct Asv_dynamics
   double P_unit_regular_wave; //!< Pressure amplitude when wave_type is set as regular_wave.
   double P_unit_wave_freq_min;//!< Minimum wave frequency considered in array P_unit_wave.
   double P_unit_wave_freq_max;//!< Maximum wave frequency considered in array P_unit_wave.
-  char* error_msg;  //!< Error message, if any.
+  const char* error_msg;  //!< Error message, if any.
 };
 
 /**
@@ -80,7 +80,7 @@ struct Asv
   struct Asv_dynamics dynamics; //!< ASV dynamics variables. 
   union Coordinates_3D cog_position; //!< Position of the centre of gravity of the ASV in  
                                      //!< the global frame for the current time step.
-  char* error_msg;  //!< Error message, if any.
+  const char* error_msg;  //!< Error message, if any.
 };
 
 // Method to compute the encounter frequency. 
@@ -631,7 +631,6 @@ void thruster_delete(struct Thruster* thruster)
 {
   if(thruster)
   {
-    free(thruster->error_msg);
     free(thruster);
     thruster = NULL;
   }
@@ -840,7 +839,6 @@ void asv_delete(struct Asv* asv)
 {
   if(asv)
   {
-    free(asv->error_msg);
     free(asv->dynamics.P_unit_wave);
     free(asv->thrusters);
     free(asv);
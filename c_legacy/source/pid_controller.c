@@ -29,7 +29,7 @@ struct Controller
   double error_position;
   double error_int_position;
   double error_diff_position;
-  char* error_msg;
+  const char* error_msg;
 };
 
 struct Controller* controller_new(struct Asv* asv)
@@ -59,7 +59,6 @@ void controller_delete(struct Controller* controller)
 {
   if(controller)
   {
-    free(controller->error_msg);
     free(controller);
     controller = NULL;
   }
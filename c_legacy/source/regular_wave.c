@@ -24,10 +24,36 @@ struct Regular_wave
   double time_period; //!< Output variable. Time period of the wave in seconds.
   double wave_length; //!< Output variable. Wave length in meter.
   double wave_number; //!< Output variable. Wave number. Dimensionless.
-  char* error_msg;    //!< Output variable. Error message, if any. 
+  const char* error_msg;    //!< Output variable. Error message, if any. 
 }; 
 
 
+struct Regular_wave* regular_wave_init(void* memory,
+                                       const double amplitude, 
+                                       const double frequency, 
+                                       const double phase_lag, 
+                                       const double direction)
+{
+  struct Regular_wave* regular_wave = NULL;
+
+  // Check if both amplitude and frequency are non-zero positive values. 
+  if(memory && amplitude > 0.0 && frequency > 0.0)
+  {
+    regular_wave = (struct Regular_wave*)memory;
+    regular_wave->error_msg = NULL;
+    regular_wave->amplitude = amplitude; 
+    regular_wave->frequency = frequency;
+    regular_wave->phase_lag = phase_lag;
+    regular_wave->direction = normalise_angle_2PI(direction);
+    regular_wave->time_period = (1.0/frequency);
+    regular_wave->wave_length = (G * regular_wave->time_period * regular_wave->time_period)/(2.0 * PI);
+    regular_wave->wave_number = (2.0 * PI)/regular_wave->wave_length;
+  }
+  
+  return regular_wave;  
+}
+
+
 struct Regular_wave* regular_wave_new(const double amplitude, 
                                       const double frequency, 
                                       const double phase_lag, 
@@ -40,14 +66,7 @@ struct Regular_wave* regular_wave_new(const double amplitude,
   {
     if(regular_wave = (struct Regular_wave*)malloc(sizeof(struct Regular_wave)))
     {
-      regular_wave->error_msg = NULL;
-      regular_wave->amplitude = amplitude; 
-      regular_wave->frequency = frequency;
-      regular_wave->phase_lag = phase_lag;
-      regular_wave->direction = normalise_angle_2PI(direction);
-      regular_wave->time_period = (1.0/frequency);
-      regular_wave->wave_length = (G * regular_wave->time_period * regular_wave->time_period)/(2.0 * PI);
-      regular_wave->wave_number = (2.0 * PI)/regular_wave->wave_length;
+      regular_wave_init(regular_wave, amplitude, frequency, phase_lag, direction);
     }
   }
   
@@ -55,11 +74,16 @@ struct Regular_wave* regular_wave_new(const double amplitude,
 }
 
 
+size_t regular_wave_get_size()
+{
+  return sizeof(struct Regular_wave);
+}
+
+
 void regular_wave_delete(struct Regular_wave* regular_wave)
 {
   if(regular_wave)
   {
-    free(regular_wave->error_msg);
     free(regular_wave);
     regular_wave = NULL;
   }
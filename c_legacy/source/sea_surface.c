@@ -10,6 +10,8 @@
 #include "sea_surface.h"
 #include "errors.h"
 
+#define SPECTRUM_ALIGNMENT 64 /*!< Alignment, in bytes, of the arrays of the spectrum. */
+
 struct Sea_surface
 {
   // Input variables
@@ -21,13 +23,23 @@ struct Sea_surface
 
   // Output variables
   // ----------------
-  struct Regular_wave** spectrum;   //!< Output variable. Table of regular waves in the irregular sea. Size is count_component_waves.
+  // The spectrum as contiguous arrays, each of size count_component_waves, in one aligned block. 
+  double* amplitudes;               //!< Output variable. Amplitude of each regular wave in meter.
+  double* frequencies;              //!< Output variable. Frequency of each regular wave in Hz.
+  double* phase_lags;               //!< Output variable. Phase lag of each regular wave in radian.
+  double* directions;               //!< Output variable. Direction of propagation of each regular wave, in radians with respect to geographic north.
+  // Computed from the arrays above, for computing the elevation.
+  double* angular_frequencies;      //!< Output variable. Angular frequency of each regular wave in rad/s.
+  double* wavenumbers_x;            //!< Output variable. Wave number times sin(direction) of each regular wave.
+  double* wavenumbers_y;            //!< Output variable. Wave number times cos(direction) of each regular wave.
+  // Regular waves initialised from the arrays above, in the same block, for sea_surface_get_regular_wave_at().
+  char* regular_waves;              //!< Output variable. count_component_waves regular waves, each regular_wave_get_size() bytes.
   double min_spectral_frequency;    //!< Output variable. Lower limit (0.1%) of spectral energy threshold.
   double max_spectral_frequency;    //!< Output variable. Upper limit (99.9%) of spectral energy threshold.
   double peak_spectral_frequency;   //!< Output variable. Spectral peak frequency in Hz.
   double min_spectral_wave_heading; //!< Output variable. Minimum angle, in radians, in spectrum for wave heading.
   double max_spectral_wave_heading; //!< Output variable. Maximum angle, in radians, in spectrum for wave heading.
-  char* error_msg;                  //!< Output variable. Error message, if any.
+  const char* error_msg;                  //!< Output variable. Error message, if any.
 };
 
 const char* sea_surface_get_error_msg(const struct Sea_surface* sea_surface)
@@ -54,15 +66,18 @@ static struct Sea_surface* sea_surface_from_wave_or_wind(const int option_wave_o
     // Initialise the pointers...
     if(sea_surface = (struct Sea_surface*)malloc(sizeof(struct Sea_surface)))
     {
-      sea_surface->spectrum = NULL;
-      double* wave_frequencies = (double*)malloc(sizeof(double) * count_component_waves); // List of frequencies for the component waves
+      sea_surface->count_component_waves = 0;
       double* wave_frequency_band_sizes = (double*)malloc(sizeof(double) * count_component_waves); // Corresponding list of the freq step size
-      double* wave_headings = (double*)malloc(sizeof(double) * count_component_waves);  // Corresponding list of headings for the component waves
-      sea_surface->spectrum = (struct Regular_wave**)malloc(sizeof(struct Regular_wave*) * count_component_waves);
-      if(sea_surface->spectrum && 
-         wave_frequencies      && 
-         wave_frequency_band_sizes  &&
-         wave_headings) // Check if memory has been allocated in all cases. 
+      // One aligned block for the arrays of the spectrum, each padded to a multiple of the alignment, 
+      // followed by the regular waves.
+      const int count_per_alignment = SPECTRUM_ALIGNMENT / sizeof(double);
+      const int count_padded = ((count_component_waves + count_per_alignment - 1) / count_per_alignment) * count_per_alignment;
+      const size_t size_arrays = sizeof(double) * 7 * count_padded;
+      const size_t size_regular_waves = regular_wave_get_size() * count_component_waves;
+      const size_t size_block = ((size_arrays + size_regular_waves + SPECTRUM_ALIGNMENT - 1) / SPECTRUM_ALIGNMENT) * SPECTRUM_ALIGNMENT;
+      sea_surface->amplitudes = (double*)aligned_alloc(SPECTRUM_ALIGNMENT, size_block);
+      if(sea_surface->amplitudes &&
+         wave_frequency_band_sizes) // Check if memory has been allocated in all cases. 
       {
         sea_surface->error_msg = NULL;
         // ... and then the other member variables.
@@ -70,6 +85,13 @@ static struct Sea_surface* sea_surface_from_wave_or_wind(const int option_wave_o
         srand(sea_surface->random_number_seed);
         sea_surface->heading = normalise_angle_2PI(wave_heading);
         sea_surface->count_component_waves = count_component_waves;
+        sea_surface->frequencies = sea_surface->amplitudes + count_padded;
+        sea_surface->phase_lags = sea_surface->amplitudes + 2 * count_padded;
+        sea_surface->directions = sea_surface->amplitudes + 3 * count_padded;
+        sea_surface->angular_frequencies = sea_surface->amplitudes + 4 * count_padded;
+        sea_surface->wavenumbers_x = sea_surface->amplitudes + 5 * count_padded;
+        sea_surface->wavenumbers_y = sea_surface->amplitudes + 6 * count_padded;
+        sea_surface->regular_waves = (char*)sea_surface->amplitudes + size_arrays;
         sea_surface->min_spectral_wave_heading = normalise_angle_2PI(sea_surface->heading - PI/2.0);
         sea_surface->max_spectral_wave_heading = normalise_angle_2PI(sea_surface->heading + PI/2.0);
         
@@ -112,9 +134,9 @@ static struct Sea_surface* sea_surface_from_wave_or_wind(const int option_wave_o
         double wave_heading_increment = PI/count_component_waves;
         // Create a list of frequencies and headings
         // The first in the list is the predominant wave with the freq = peak frequency and heading = wave_heading.
-        wave_frequencies[0] = f_p;
+        sea_surface->frequencies[0] = f_p;
         wave_frequency_band_sizes[0] = frequency_band_size;
-        wave_headings[0] = wave_heading;
+        sea_surface->directions[0] = wave_heading;
         // Now create the rest of the waves
         if(count_component_waves > 1)
         {
@@ -127,9 +149,9 @@ static struct Sea_surface* sea_surface_from_wave_or_wind(const int option_wave_o
             double f = sea_surface->min_spectral_frequency + (i * frequency_band_size);
             mu += wave_heading_increment;
             double wave_heading = normalise_angle_2PI(mu + sea_surface->heading);
-            wave_frequencies[i+1] = f;
+            sea_surface->frequencies[i+1] = f;
             wave_frequency_band_sizes[i+1] = frequency_band_size;
-            wave_headings[i+1] = wave_heading;
+            sea_surface->directions[i+1] = wave_heading;
           }
           // Create frequencies between f_p and max_spectral_frequency
           mu = PI/2.0;
@@ -139,53 +161,41 @@ static struct Sea_surface* sea_surface_from_wave_or_wind(const int option_wave_o
             double f = sea_surface->max_spectral_frequency - (i * frequency_band_size);
             mu -= wave_heading_increment;
             double wave_heading = normalise_angle_2PI(mu + sea_surface->heading);
-            wave_frequencies[half_count+1+i] = f;
+            sea_surface->frequencies[half_count+1+i] = f;
             wave_frequency_band_sizes[half_count+1+i] = frequency_band_size;
-            wave_headings[half_count+1+i] = wave_heading;
+            sea_surface->directions[half_count+1+i] = wave_heading;
           }
         }        
         for(int i = 0; i < count_component_waves; ++i)
         {
-          double f = wave_frequencies[i];
+          double f = sea_surface->frequencies[i];
           frequency_band_size = wave_frequency_band_sizes[i];
-          double wave_heading = wave_headings[i];
           double S = (A/pow(f,5.0)) * exp(-B/pow(f,4.0)) * frequency_band_size;
-        
-          // Create a wave
-          double amplitude = sqrt(2.0 * S); 
-          double phase = rand(); 
-          struct Regular_wave* regular_wave = regular_wave_new(amplitude, f, phase, wave_heading);
-          if(regular_wave)
-          {
-            sea_surface->spectrum[i] = regular_wave;
-          }
-          else 
+          sea_surface->amplitudes[i] = sqrt(2.0 * S); 
+          // Random phase, reduced to [0, 2PI) as cos() is much slower for large arguments.
+          sea_surface->phase_lags[i] = normalise_angle_2PI(rand()); 
+          // Regular wave viewed by sea_surface_get_regular_wave_at(), initialised from the arrays.
+          struct Regular_wave* regular_wave = regular_wave_init(sea_surface->regular_waves + i * regular_wave_get_size(),
+                                                                sea_surface->amplitudes[i],
+                                                                sea_surface->frequencies[i],
+                                                                sea_surface->phase_lags[i],
+                                                                sea_surface->directions[i]);
+          if(!regular_wave)
           {
             // Error encountered when creating a regular waves for the wave spectrum.
             has_NULL_in_spectrum = true;
             break;
           }
-          if(has_NULL_in_spectrum)
-          {
-            break;
-          }
+          // The regular wave normalises the direction, so take it back to keep the arrays and the regular wave the same.
+          sea_surface->directions[i] = regular_wave_get_direction(regular_wave);
+          double wave_number = regular_wave_get_wavenumber(regular_wave);
+          sea_surface->angular_frequencies[i] = 2.0 * PI * f;
+          sea_surface->wavenumbers_x[i] = wave_number * sin(sea_surface->directions[i]);
+          sea_surface->wavenumbers_y[i] = wave_number * cos(sea_surface->directions[i]);
         }
         // Clean memory
-        if(wave_frequencies)
-        {
-          free(wave_frequencies);
-          wave_frequencies = NULL;
-        }
-        if(wave_frequency_band_sizes)
-        {
-          free(wave_frequency_band_sizes);
-          wave_frequency_band_sizes = NULL;
-        }
-        if(wave_headings)
-        {
-          free(wave_headings);
-          wave_headings = NULL;
-        }
+        free(wave_frequency_band_sizes);
+        wave_frequency_band_sizes = NULL;
         // Check if spectrum is valid
         if(has_NULL_in_spectrum)
         {
@@ -197,26 +207,16 @@ static struct Sea_surface* sea_surface_from_wave_or_wind(const int option_wave_o
       }
       else
       {
-        if(sea_surface->spectrum)
-        {
-          free(sea_surface->spectrum);
-          sea_surface->spectrum = NULL;
-        }
-        if(wave_frequencies)
+        if(sea_surface->amplitudes)
         {
-          free(wave_frequencies);
-          wave_frequencies = NULL;
+          free(sea_surface->amplitudes);
+          sea_surface->amplitudes = NULL;
         }
         if(wave_frequency_band_sizes)
         {
           free(wave_frequency_band_sizes);
           wave_frequency_band_sizes = NULL;
         }
-        if(wave_headings)
-        {
-          free(wave_headings);
-          wave_headings = NULL;
-        }
         free(sea_surface);
         sea_surface = NULL;
       }
@@ -251,21 +251,48 @@ void sea_surface_delete(struct Sea_surface* sea_surface)
 {
   if(sea_surface)
   {
-    for(int i = 0; i < sea_surface->count_component_waves; ++i)
-    {
-      if(sea_surface->spectrum[i])
-      {
-        regular_wave_delete(sea_surface->spectrum[i]);
-      }
-    }
-    
-    free(sea_surface->spectrum);
-    free(sea_surface->error_msg);
+    // The arrays and the regular waves of the spectrum are in one block.
+    free(sea_surface->amplitudes);
     free(sea_surface);
     sea_surface = NULL;
   }
 }
 
+// Sums the elevation of the regular waves at each location. The loop over the waves 
+// is outermost so that the time dependent part of the phase is computed once per wave, 
+// and the loop over the locations has no branches or calls other than cos(), to let 
+// the compiler vectorise it.
+static void get_elevations(const struct Sea_surface* sea_surface,
+                           const union Coordinates_3D* locations,
+                           int count_locations,
+                           double time,
+                           double* restrict elevations)
+{
+  const double* restrict amplitudes = sea_surface->amplitudes;
+  const double* restrict angular_frequencies = sea_surface->angular_frequencies;
+  const double* restrict wavenumbers_x = sea_surface->wavenumbers_x;
+  const double* restrict wavenumbers_y = sea_surface->wavenumbers_y;
+  const double* restrict phase_lags = sea_surface->phase_lags;
+  for(int j = 0; j < count_locations; ++j)
+  {
+    elevations[j] = 0.0;
+  }
+  for(int i = 0; i < sea_surface->count_component_waves; ++i)
+  {
+    // elevation = amplitude * cos(A - B + phase_lag), see regular_wave_get_phase(). 
+    const double amplitude = amplitudes[i];
+    const double wavenumber_x = wavenumbers_x[i];
+    const double wavenumber_y = wavenumbers_y[i];
+    const double B = angular_frequencies[i] * time;
+    const double phase_lag = phase_lags[i];
+    for(int j = 0; j < count_locations; ++j)
+    {
+      double A = wavenumber_x * locations[j].keys.x + wavenumber_y * locations[j].keys.y;
+      elevations[j] += amplitude * cos(A - B + phase_lag);
+    }
+  }
+}
+
 double sea_surface_get_elevation(const struct Sea_surface* sea_surface, 
                           const union Coordinates_3D location,
                           double time)
@@ -277,28 +304,7 @@ double sea_surface_get_elevation(const struct Sea_surface* sea_surface,
     if(time >= 0.0)
     {
       double elevation = 0.0;
-      for(int i = 0; i < sea_surface->count_component_waves; ++i)
-      {
-        const struct Regular_wave* regular_wave = sea_surface_get_regular_wave_at(sea_surface, i);
-        if(!regular_wave)
-        {
-          // Something really wrong happened.
-          // Error should already be set by sea_surface_get_regular_wave_at().
-          return 0.0;
-        }
-        double regular_wave_elevation = regular_wave_get_elevation(regular_wave, location, time);
-        const char* error_msg = regular_wave_get_error_msg(regular_wave);
-        if(error_msg)
-        {
-          // Something went wrong when getting wave elevation for the regular_wave.
-          set_error_msg(&sea_surface->error_msg, error_msg);
-          return 0.0;
-        }
-        else
-        {
-          elevation += regular_wave_elevation;
-        }
-      }
+      get_elevations(sea_surface, &location, 1, time, &elevation);
       return elevation;
     }
     else
@@ -313,6 +319,34 @@ double sea_surface_get_elevation(const struct Sea_surface* sea_surface,
   }
 }
 
+void sea_surface_get_elevations(const struct Sea_surface* sea_surface, 
+                                const union Coordinates_3D* locations, 
+                                int count_locations,
+                                double time,
+                                double* elevations)
+{
+  if(sea_surface)
+  {
+    clear_error_msg(&sea_surface->error_msg);
+    if(locations && elevations)
+    {
+      // check if time is negative
+      if(time >= 0.0)
+      {
+        get_elevations(sea_surface, locations, count_locations, time, elevations);
+      }
+      else
+      {
+        set_error_msg(&sea_surface->error_msg, error_negative_time);
+      }
+    }
+    else
+    {
+      set_error_msg(&sea_surface->error_msg, error_null_pointer);
+    }
+  }
+}
+
 const struct Regular_wave* sea_surface_get_regular_wave_at(const struct Sea_surface* sea_surface, int i)
 {
   if(sea_surface)
@@ -320,7 +354,7 @@ const struct Regular_wave* sea_surface_get_regular_wave_at(const struct Sea_surf
     clear_error_msg(&sea_surface->error_msg);
     if(i >= 0 && i < sea_surface->count_component_waves)
     {
-      return sea_surface->spectrum[i];
+      return (const struct Regular_wave*)(sea_surface->regular_waves + i * regular_wave_get_size());
     }
     else
     {
@@ -1,7 +1,9 @@
 #include <stdlib.h>
 #include <sys/stat.h> // for creating directory
 #include <pthread.h>
+#include <stdatomic.h>
 #include <string.h>
+#include <unistd.h> // for the number of processors
 #include "toml.h"
 #include "simulation.h"
 #include "pid_controller.h"
@@ -13,12 +15,216 @@
 
 #define OUTPUT_BUFFER_SIZE 200000 /*!< Output buffer size. */
 
-struct Thread_args
+#define THREAD_POOL_CHUNK_SIZE 4 /*!< Number of nodes a worker takes from the pool at a time when each node is stepped once. */
+
+struct Node;
+
+/**
+ * Barrier at which the threads of a pool wait for each other. 
+ */
+struct Barrier
 {
-  struct Simulation* node;
+  pthread_mutex_t mutex;
+  pthread_cond_t condition;
+  int count_threads;  // Number of threads to wait for.
+  int count_waiting;  // Number of threads waiting at the barrier.
+  long generation;    // Number of times the barrier was passed.
+};
+
+/**
+ * Fixed pool of threads that run a function on each node of a list of nodes. The threads are created 
+ * once per simulation run. In each round, the nodes are taken by the threads in chunks from a shared 
+ * counter, so that threads that finish early take more nodes, and all threads meet at a barrier at the 
+ * end of the round. The calling thread works as one of the threads of the pool. 
+ */
+struct Thread_pool
+{
+  pthread_t* workers;   // Worker threads, one fewer than count_threads.
+  int count_threads;    // Number of threads including the calling thread.
+  struct Barrier start; // Barrier at the start of a round.
+  struct Barrier end;   // Barrier at the end of a round.
+  bool is_stopping;     // Set to stop the workers at the start of the next round.
+  // Work of the current round
+  void (*function)(struct Node*, char*);
+  struct Node** nodes;
+  int count_nodes;
   char* out_dir;
+  int chunk_size;       // Number of nodes a thread takes at a time.
+  atomic_int next_node; // Index of the next node to be taken.
 };
 
+static void barrier_init(struct Barrier* barrier, int count_threads)
+{
+  pthread_mutex_init(&barrier->mutex, NULL);
+  pthread_cond_init(&barrier->condition, NULL);
+  barrier->count_threads = count_threads;
+  barrier->count_waiting = 0;
+  barrier->generation = 0;
+}
+
+static void barrier_destroy(struct Barrier* barrier)
+{
+  pthread_mutex_destroy(&barrier->mutex);
+  pthread_cond_destroy(&barrier->condition);
+}
+
+static void barrier_wait(struct Barrier* barrier)
+{
+  pthread_mutex_lock(&barrier->mutex);
+  long generation = barrier->generation;
+  if(++(barrier->count_waiting) == barrier->count_threads)
+  {
+    // Last thread to arrive. Release all.
+    barrier->count_waiting = 0;
+    ++(barrier->generation);
+    pthread_cond_broadcast(&barrier->condition);
+  }
+  else
+  {
+    while(generation == barrier->generation)
+    {
+      pthread_cond_wait(&barrier->condition, &barrier->mutex);
+    }
+  }
+  pthread_mutex_unlock(&barrier->mutex);
+}
+
+// Runs the function of the current round on nodes taken from the pool till none are left.
+static void thread_pool_run_nodes(struct Thread_pool* pool)
+{
+  for(int begin = atomic_fetch_add(&pool->next_node, pool->chunk_size); 
+      begin < pool->count_nodes; 
+      begin = atomic_fetch_add(&pool->next_node, pool->chunk_size))
+  {
+    int end = (begin + pool->chunk_size < pool->count_nodes) ? begin + pool->chunk_size : pool->count_nodes;
+    for(int i = begin; i < end; ++i)
+    {
+      pool->function(pool->nodes[i], pool->out_dir);
+    }
+  }
+}
+
+static void* thread_pool_run_worker(void* args)
+{
+  struct Thread_pool* pool = (struct Thread_pool*)args;
+  for(;;)
+  {
+    barrier_wait(&pool->start);
+    if(pool->is_stopping)
+    {
+      break;
+    }
+    thread_pool_run_nodes(pool);
+    barrier_wait(&pool->end);
+  }
+  return NULL;
+}
+
+static void thread_pool_delete(struct Thread_pool* pool);
+
+// Sets the number of threads to wait for at a barrier. 
+static void barrier_set_count_threads(struct Barrier* barrier, int count_threads)
+{
+  pthread_mutex_lock(&barrier->mutex);
+  barrier->count_threads = count_threads;
+  pthread_mutex_unlock(&barrier->mutex);
+}
+
+// Creates the pool. count_threads includes the calling thread, and 0 is the number of processors.
+// Returns NULL and sets p_error_msg if the pool could not be created. 
+static struct Thread_pool* thread_pool_new(int count_threads, const char* const* p_error_msg)
+{
+  if(count_threads <= 0)
+  {
+    long count_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    count_threads = (count_processors > 0) ? (int)count_processors : 1;
+  }
+  struct Thread_pool* pool = (struct Thread_pool*)malloc(sizeof(struct Thread_pool));
+  if(!pool)
+  {
+    set_error_msg(p_error_msg, error_malloc_failed);
+    return NULL;
+  }
+  pool->workers = (pthread_t*)malloc(sizeof(pthread_t) * count_threads);
+  if(!pool->workers)
+  {
+    free(pool);
+    set_error_msg(p_error_msg, error_malloc_failed);
+    return NULL;
+  }
+  pool->count_threads = count_threads;
+  pool->is_stopping = false;
+  pool->function = NULL;
+  pool->nodes = NULL;
+  pool->count_nodes = 0;
+  pool->out_dir = NULL;
+  pool->chunk_size = 1;
+  atomic_init(&pool->next_node, 0);
+  barrier_init(&pool->start, count_threads);
+  barrier_init(&pool->end, count_threads);
+  for(int i = 0; i < count_threads - 1; ++i)
+  {
+    if(pthread_create(&(pool->workers[i]), NULL, &thread_pool_run_worker, (void*)pool) != 0)
+    {
+      // The workers already created wait at the start barrier for count_threads threads. Lower the count 
+      // to the threads that exist so that they can be stopped and joined.
+      pool->count_threads = i + 1;
+      barrier_set_count_threads(&pool->start, pool->count_threads);
+      barrier_set_count_threads(&pool->end, pool->count_threads);
+      thread_pool_delete(pool);
+      set_error_msg(p_error_msg, error_thread_create_failed);
+      return NULL;
+    }
+  }
+  return pool;
+}
+
+static void thread_pool_delete(struct Thread_pool* pool)
+{
+  if(pool)
+  {
+    if(pool->count_threads > 1)
+    {
+      pool->is_stopping = true;
+      barrier_wait(&pool->start);
+      for(int i = 0; i < pool->count_threads - 1; ++i)
+      {
+        pthread_join(pool->workers[i], NULL);
+      }
+    }
+    barrier_destroy(&pool->start);
+    barrier_destroy(&pool->end);
+    free(pool->workers);
+    free(pool);
+  }
+}
+
+// Runs function on each node and returns when all are done. The threads take chunk_size nodes at a time. 
+static void thread_pool_run(struct Thread_pool* pool, 
+                            void (*function)(struct Node*, char*), 
+                            struct Node** nodes, 
+                            int count_nodes, 
+                            int chunk_size,
+                            char* out_dir)
+{
+  pool->function = function;
+  pool->nodes = nodes;
+  pool->count_nodes = count_nodes;
+  pool->chunk_size = chunk_size;
+  pool->out_dir = out_dir;
+  atomic_store(&pool->next_node, 0);
+  if(pool->count_threads > 1)
+  {
+    barrier_wait(&pool->start);
+    thread_pool_run_nodes(pool);
+    barrier_wait(&pool->end);
+  }
+  else
+  {
+    thread_pool_run_nodes(pool);
+  }
+}
+
 /**
  * Structure to record the sea state and vehicle dynamics for a time step of the simulation.
  */
@@ -42,15 +248,14 @@ struct Buffer
 };
 
 /**
- * Simulation is a node in a linked list and it stores simulation data related to a vehicle in simulation.
+ * Node stores simulation data related to a vehicle in simulation.
  */
-struct Simulation
+struct Node
 {
-  // Each simulation runs on its own thread
-  pthread_t thread;
   // Inputs and outputs
   char id[32];
-  struct Wave* sea_surface;
+  struct Sea_surface* sea_surface; // Shared by the nodes of a simulation.
+  bool owns_sea_surface; // true for the one node that frees the sea surface.
   struct Asv* asv; 
   struct Controller* controller;
   union Coordinates_3D* waypoints;
@@ -62,15 +267,26 @@ struct Simulation
   int buffer_index;
   double max_time; // seconds
   int current_waypoint_index;
+  const char* error_msg;
+};
 
-  // Link pointers
-  struct Simulation* previous; // previous in the linked list.
-  struct Simulation* next; // next in the linked list.
+/**
+ * Simulation is a registry of the vehicles in simulation. The nodes are stored in a 
+ * contiguous array, and a vehicle is identified by the index of its node, which does 
+ * not change during the lifetime of the simulation.
+ */
+struct Simulation
+{
+  struct Node* nodes;
+  int count_nodes;
+  int capacity_nodes; // Number of nodes for which memory is allocated.
   void (*simulation_run)(struct Simulation*, char*); // Pointer to function for executing the simulation. 
-  char* error_msg;
+  int count_threads; // Number of threads to run the simulation on, 0 for the number of processors.
+  const char* error_msg;
+  char error_msg_buffer[128]; // Storage for error messages formatted at runtime.
 };
 
-static void simulation_write_output(struct Simulation* node, char* out_dir)
+static void simulation_write_output(struct Node* node, char* out_dir)
 {
   // Check if the directory exist and create it if it does not.
   struct stat st = {0};
@@ -133,10 +349,12 @@ static void simulation_write_output(struct Simulation* node, char* out_dir)
   fclose(fp);
 }
 
-// Computes dynamics for current node for the current time step.
-static void* simulation_run_per_node_per_time_step(void* current_node)
+// Computes dynamics for current node for the current time step. The output 
+// directory is not used, and is a parameter only to run the function on a Thread_pool.
+static void simulation_run_per_node_per_time_step(struct Node* node, char* out_dir)
 {
-  struct Simulation* node = (struct Simulation*)current_node;
+  (void)out_dir;
+
   // Current time
   double current_time = (node->current_time_index+1) * node->time_step_size/1000.0; //sec
 
@@ -151,7 +369,7 @@ static void* simulation_run_per_node_per_time_step(void* current_node)
   if(error_msg)
   {
     set_error_msg(&node->error_msg, error_msg);
-    return NULL;
+    return;
   }
   struct Asv_specification spec = asv_get_spec(node->asv);
   union Coordinates_3D cog_position = asv_get_position_cog(node->asv);
@@ -186,15 +404,10 @@ static void* simulation_run_per_node_per_time_step(void* current_node)
   }
   // Increment buffer counter
   ++(node->buffer_index);
-  return NULL;
 }
 
-static void* simulation_run_per_node_without_time_sync(void* args)
+static void simulation_run_per_node_without_time_sync(struct Node* node, char* out_dir)
 {
-  // Extract the arguments passed
-  struct Simulation* node = (struct Simulation*)((struct Thread_args*)args)->node;
-  char* out_dir = (char*)((struct Thread_args*)args)->out_dir;
-
   for(node->current_time_index = 0; 
       node->max_time == 0 || node->current_time_index*node->time_step_size/1000.0 < node->max_time; 
       ++(node->current_time_index))
@@ -222,7 +435,7 @@ static void* simulation_run_per_node_without_time_sync(void* args)
         break;
       }
       // If buffer not exceeded and no error.
-      simulation_run_per_node_per_time_step((void*)node);
+      simulation_run_per_node_per_time_step(node, out_dir);
     }
     else
     {
@@ -230,26 +443,44 @@ static void* simulation_run_per_node_without_time_sync(void* args)
       break;
     }
   }
-  return NULL;
 }
 
-static void simulation_spawn_nodes_with_time_sync(void* args)
+// Returns pointers to the nodes of the simulation, to be freed by the caller.
+static struct Node** simulation_get_nodes(struct Simulation* simulation)
 {
-  // Extract the arguments passed
-  struct Simulation* first_node = (struct Simulation*)((struct Thread_args*)args)->node;
-  char* out_dir = (char*)((struct Thread_args*)args)->out_dir;
+  struct Node** nodes = (struct Node**)malloc(sizeof(struct Node*) * simulation->count_nodes);
+  for(int i = 0; i < simulation->count_nodes; ++i)
+  {
+    nodes[i] = &(simulation->nodes[i]);
+  }
+  return nodes;
+}
 
-  bool buffer_exceeded = false;
-  for(long t = 0; ; ++t)
+/**
+ * Simulate vehicle dynamics for each time step, with all ASVs at the same 
+ * time step. The ASVs are stepped on a pool of threads created once for the 
+ * run, and the threads wait for each other at the end of each time step.
+ */
+static void simulation_spawn_nodes_with_time_sync(struct Simulation* simulation, char* out_dir)
+{
+  int count_nodes = simulation->count_nodes;
+  struct Node** nodes = simulation_get_nodes(simulation);
+  // Nodes to be stepped in the current time step.
+  struct Node** active_nodes = (struct Node**)malloc(sizeof(struct Node*) * count_nodes);
+  struct Thread_pool* pool = thread_pool_new(simulation->count_threads, &simulation->error_msg);
+  if(!pool)
   {
-    // Variable to check if all reached the destination.
-    bool has_all_reached_final_waypoint = true;
+    free(active_nodes);
+    free(nodes);
+    return;
+  }
 
-    // Create threads
-    // int limit_threads = get_nprocs();
-    // spawn threads
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
+  for(long t = 0; ; ++t)
+  {
+    int count_active_nodes = 0;
+    for(int i = 0; i < count_nodes; ++i)
     {
+      struct Node* node = nodes[i];
       // Set time step for the node
       node->current_time_index = t;
 
@@ -276,134 +507,193 @@ static void simulation_spawn_nodes_with_time_sync(void* args)
             // Reset buffer
             node->buffer_index = 0;
           }
-          has_all_reached_final_waypoint = false;
-          struct Thread_args args;
-          args.node = node;
-          args.out_dir = out_dir;
-          #ifdef DISABLE_MULTI_THREADING
-          simulation_run_per_node_per_time_step((void*)&args);
-          if(node->error_msg)
-          {
-            break;
-          }
-          #else
-          pthread_create(&(node->thread), NULL, &simulation_run_per_node_per_time_step, (void*)&args);
-          #endif
+          active_nodes[count_active_nodes++] = node;
         }
       }
     }
-    // Join threads. Also check if there were errors in any node.
+
+    // stop if all reached the destination.
+    if(count_active_nodes == 0)
+    {
+      break;
+    }
+
+    // Step the nodes on the pool and wait for all to finish the time step.
+    thread_pool_run(pool, simulation_run_per_node_per_time_step, active_nodes, count_active_nodes, THREAD_POOL_CHUNK_SIZE, out_dir);
+
+    // Check if there were errors in any node.
     bool has_error = false;
-    #ifndef DISABLE_MULTI_THREADING
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
+    for(int i = 0; i < count_active_nodes; ++i)
     {
-      if(node->current_waypoint_index < node->count_waypoints)
+      if(active_nodes[i]->error_msg)
       {
-        if(node->error_msg)
-        {
-          has_error = true;
-        }
-        pthread_join(node->thread, NULL);
+        has_error = true;
       }
     }
-    #endif
-
-    // stop if all reached the destination or if buffer exceeded.
-    if(has_all_reached_final_waypoint || buffer_exceeded || has_error)
+    if(has_error)
     {
       break;
     }
   }
+
+  thread_pool_delete(pool);
+  free(active_nodes);
+  free(nodes);
 }
 
 /**
  * Simulate vehicle dynamics for each time step. This function runs 
- * simultion of each ASV in a independent thread and does not synchronize
- * the simulation for each time step between ASVs. This function is faster
- * compared to the alternative simulate_with_time_sync().
+ * simultion of each ASV independently on a pool of threads and does not 
+ * synchronize the simulation for each time step between ASVs. This function 
+ * is faster compared to the alternative simulate_with_time_sync().
  */
-static void simulation_spawn_nodes_without_time_sync(struct Simulation* first_node, char* out_dir)
+static void simulation_spawn_nodes_without_time_sync(struct Simulation* simulation, char* out_dir)
 {
-  for(struct Simulation* node = first_node; node != NULL; node = node->next)
+  struct Node** nodes = simulation_get_nodes(simulation);
+  struct Thread_pool* pool = thread_pool_new(simulation->count_threads, &simulation->error_msg);
+  if(pool)
   {
-    struct Thread_args args;
-    args.node = node;
-    args.out_dir = out_dir;
-    pthread_create(&(node->thread), NULL, &simulation_run_per_node_without_time_sync, (void*)&args);
-  }
-  // join threads
-  for(struct Simulation* node = first_node; node != NULL; node = node->next)
-  {
-    if(node->current_waypoint_index < node->count_waypoints)
-    {
-      pthread_join(node->thread, NULL);
-    }
+    // Each node is a whole run, so the threads take one node at a time to share the runs between them.
+    thread_pool_run(pool, simulation_run_per_node_without_time_sync, nodes, simulation->count_nodes, 1, out_dir);
+    thread_pool_delete(pool);
   }
+  free(nodes);
 }
 
-struct Simulation* simulation_new_node()
+// Initialises a node.
+static void simulation_init_node(struct Node* node)
 {
-  // Initialise memory
-  struct Simulation* node = (struct Simulation*)malloc(sizeof(struct Simulation));
+  node->id[0] = '\0';
   node->sea_surface = NULL;
+  node->owns_sea_surface = false;
   node->asv = NULL;
   node->controller = NULL;
   node->waypoints = NULL;
   node->buffer = (struct Buffer*)malloc(OUTPUT_BUFFER_SIZE * sizeof(struct Buffer));
-  node->previous = NULL;
-  node->next = NULL;
   node->error_msg = NULL;
-  node->simulation_run = NULL;
   node->count_waypoints = 0;
   node->time_step_size = 40.0;
   node->current_time_index = 0;
+  node->buffer_index = 0;
   node->max_time = 0.0;
   node->current_waypoint_index = 0;
+}
+
+// Reserves memory for count_nodes nodes in total. Pointers to the nodes are 
+// invalidated if the array is moved, but not the indices of the nodes.
+static bool simulation_reserve_nodes(struct Simulation* simulation, int count_nodes)
+{
+  if(count_nodes > simulation->capacity_nodes)
+  {
+    struct Node* nodes = (struct Node*)realloc(simulation->nodes, sizeof(struct Node) * count_nodes);
+    if(!nodes)
+    {
+      set_error_msg(&simulation->error_msg, error_malloc_failed);
+      return false;
+    }
+    simulation->nodes = nodes;
+    simulation->capacity_nodes = count_nodes;
+  }
+  return true;
+}
+
+// Adds a node at the end of the array of nodes and returns it, or returns NULL 
+// if memory allocation failed. The index of the node is count_nodes - 1.
+static struct Node* simulation_add_node(struct Simulation* simulation)
+{
+  if(simulation->count_nodes == simulation->capacity_nodes)
+  {
+    int capacity_nodes = (simulation->capacity_nodes > 0) ? 2 * simulation->capacity_nodes : 8;
+    if(!simulation_reserve_nodes(simulation, capacity_nodes))
+    {
+      return NULL;
+    }
+  }
+  struct Node* node = &(simulation->nodes[simulation->count_nodes]);
+  simulation_init_node(node);
+  ++(simulation->count_nodes);
   return node;
 }
 
+// Returns the node of the asv, or NULL if the asv is not in the simulation.
+static struct Node* simulation_find_node(struct Simulation* simulation, struct Asv* asv)
+{
+  for(int i = 0; i < simulation->count_nodes; ++i)
+  {
+    if(simulation->nodes[i].asv == asv)
+    {
+      return &(simulation->nodes[i]);
+    }
+  }
+  return NULL;
+}
+
+// Returns the node at the given index, or NULL and sets the error message if the index is invalid.
+static struct Node* simulation_get_node(struct Simulation* simulation, int asv_index)
+{
+  if(asv_index >= 0 && asv_index < simulation->count_nodes)
+  {
+    return &(simulation->nodes[asv_index]);
+  }
+  set_error_msg(&simulation->error_msg, error_invalid_index);
+  return NULL;
+}
+
 struct Simulation* simulation_new()
 {
-  return simulation_new_node();
+  struct Simulation* simulation = (struct Simulation*)malloc(sizeof(struct Simulation));
+  if(simulation)
+  {
+    simulation->nodes = NULL;
+    simulation->count_nodes = 0;
+    simulation->capacity_nodes = 0;
+    simulation->simulation_run = NULL;
+    simulation->count_threads = 0;
+    simulation->error_msg = NULL;
+  }
+  return simulation;
 }
 
-void simulation_delete(struct Simulation* first_node)
+void simulation_delete(struct Simulation* simulation)
 {
-  if(first_node)
+  if(simulation)
   {
-  for(struct Simulation* current_node = first_node; current_node != NULL;)
-    {
-      sea_surface_delete(current_node->sea_surface);
-      asv_delete(current_node->asv);
-      free(current_node->error_msg);
-      free(current_node->buffer);
-      free(current_node->waypoints);
-      free(current_node);
-      struct Simulation* next_node = current_node->next;
-      current_node->next = NULL;
-      current_node = next_node;
+    for(int i = 0; i < simulation->count_nodes; ++i)
+    {
+      struct Node* node = &(simulation->nodes[i]);
+      if(node->owns_sea_surface)
+      {
+        sea_surface_delete(node->sea_surface);
+      }
+      asv_delete(node->asv);
+      controller_delete(node->controller);
+      free(node->buffer);
+      free(node->waypoints);
     }
+    free(simulation->nodes);
+    free(simulation);
   }
 }
 
-void simulation_set_input_using_file(struct Simulation* first_node,
+void simulation_set_input_using_file(struct Simulation* simulation,
                                      char *file,  
                                      double wave_ht, 
                                      double wave_heading, 
                                      long rand_seed,
                                      bool with_time_sync)
 {
-  char error_buffer[100];
-  char* error_missing_table = "Error in input file. Missing %s.";
-  char* error_missing_variable = "Error in input file. Missing variable %s in %s[%d].";
-  char* error_bad_value = "Error in input file. Bad value for variable %s in %s[%d].";
+  // Names are bounded so that every message fits in the error message buffer of the simulation.
+  char* error_missing_table = "Error in input file. Missing %.32s.";
+  char* error_missing_variable = "Error in input file. Missing variable %.32s in %.32s[%d].";
+  char* error_bad_value = "Error in input file. Bad value for variable %.32s in %.32s[%d].";
 
-  if(!first_node)
+  if(!simulation)
   {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
     return;
   }
-  clear_error_msg(&first_node->error_msg);
+  clear_error_msg(&simulation->error_msg);
+  // Formatted error messages are written to the simulation, as the error message only points to them.
+  char* error_buffer = simulation->error_msg_buffer;
 
   // buffer to hold raw data from input file.
   const char *raw;
@@ -414,13 +704,13 @@ void simulation_set_input_using_file(struct Simulation* first_node,
   {
     if(sizeof(file) > 70)
     {
-      snprintf(error_buffer, sizeof(error_buffer), "Cannot open input file.");
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), "Cannot open input file.");
     }
     else
     {
-      snprintf(error_buffer, sizeof(error_buffer), "Cannot open input file %s.", file);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), "Cannot open input file %s.", file);
     }
-    set_error_msg(&first_node->error_msg, error_buffer);
+    set_error_msg(&simulation->error_msg, error_buffer);
     return;
   }
 
@@ -430,7 +720,7 @@ void simulation_set_input_using_file(struct Simulation* first_node,
   fclose(fp);
   if (input == 0)
   {
-    set_error_msg(&first_node->error_msg, "Error parsing toml file.");
+    set_error_msg(&simulation->error_msg, "Error parsing toml file.");
     return;
   }
 
@@ -438,58 +728,55 @@ void simulation_set_input_using_file(struct Simulation* first_node,
   toml_array_t *tables = toml_array_in(input, "asv");
   if (tables == 0)
   {
-    snprintf(error_buffer, sizeof(error_buffer), error_missing_table, "[[asv]]");
-    set_error_msg(&first_node->error_msg, error_buffer);
+    snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_table, "[[asv]]");
+    set_error_msg(&simulation->error_msg, error_buffer);
     return;
   }
   
+  // Create and initialise the sea surface, shared by all asvs.
+  struct Sea_surface* sea_surface = NULL;
+  if(wave_ht)
+  {
+    int count_component_waves = 21;
+    sea_surface = sea_surface_new(wave_ht, 
+                                  normalise_angle_2PI(wave_heading * PI/180.0), 
+                                  rand_seed, 
+                                  count_component_waves);
+    if(!sea_surface)
+    {
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), "Could not create sea_surface with height %lf, heading %lf, rand seed %ld", wave_ht, wave_heading, rand_seed);
+      set_error_msg(&simulation->error_msg, error_buffer);
+      return;
+    }
+  }
+
+  // Set the Pointer to function for executing the simulation.
+  if(with_time_sync)
+  {
+    simulation->simulation_run = simulation_spawn_nodes_with_time_sync;
+  }
+  else
+  {
+    simulation->simulation_run = simulation_spawn_nodes_without_time_sync;
+  }
+
   // get number of asvs
   int count_asvs = toml_array_nelem(tables);
+  int index_first_asv = simulation->count_nodes;
+  if(!simulation_reserve_nodes(simulation, index_first_asv + count_asvs))
+  {
+    sea_surface_delete(sea_surface);
+    return;
+  }
   // iterate each asv table
-  struct Simulation* current = first_node;
   for (int n = 0; n < count_asvs; ++n)
   {
-    // Create a new entry to the linked list of simulation data.
-    if(n != 0)
-    {
-      struct Simulation* previous = current;
-      // Create a new entry to the linked list.
-      current = simulation_new_node();
-      // Link it to the previous entry in the linked list.
-      previous->next = current; 
-      current->previous = previous;
-    } 
+    // Add a node for the asv.
+    struct Node* current = simulation_add_node(simulation);
     
-    // Set the Pointer to function for executing the simulation.
-    if(with_time_sync)
-    {
-      current->simulation_run = simulation_spawn_nodes_with_time_sync;
-    }
-    else
-    {
-      current->simulation_run = simulation_spawn_nodes_without_time_sync;
-    }
-    // Create and initialise the sea surface
-    if(wave_ht)
-    {
-      int count_wave_spectral_directions  = 5;
-      int count_wave_spectral_frequencies = 15;
-      current->sea_surface = sea_surface_new(wave_ht, 
-                              normalise_angle_2PI(wave_heading * PI/180.0), 
-                              rand_seed, 
-                              count_wave_spectral_directions, 
-                              count_wave_spectral_frequencies);
-      if(!current->sea_surface)
-      {
-        snprintf(error_buffer, sizeof(error_buffer), "Could not create sea_surface with height %lf, heading %lf, rand seed %d", wave_ht, wave_heading, rand_seed);
-        set_error_msg(&first_node->error_msg, error_buffer);
-        return;
-      }
-    }
-    else
-    {
-      current->sea_surface = NULL;
-    }
+    // Set the sea surface. The first node frees it.
+    current->sea_surface = sea_surface;
+    current->owns_sea_surface = (n == 0 && sea_surface != NULL);
     
     // ASV specification
     struct Asv_specification asv_spec;
@@ -498,8 +785,8 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     toml_table_t *table = toml_table_at(tables, n);
     if (table == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_table, "[asv]");
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_table, "[asv]");
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // Extract values in table [asv]
@@ -508,14 +795,14 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     char* id;
     if(raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "id", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "id", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtos(raw, &id))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "id", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "id", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     else
@@ -527,84 +814,84 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     raw = toml_raw_in(table, "L_wl");
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "L_wl", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "L_wl", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.L_wl)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "L_wl", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "L_wl", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // B_wl
     raw = toml_raw_in(table, "B_wl");
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "B_wl", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "B_wl", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.B_wl)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "B_wl", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "B_wl", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // D
     raw = toml_raw_in(table, "D");
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "D", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "D", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.D)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "D", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "D", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // T
     raw = toml_raw_in(table, "T");
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "T", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "T", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.T)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "T", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "T", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // displacement
     raw = toml_raw_in(table, "displacement");
     if (raw == 0) 
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "displacement", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "displacement", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.disp)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "displacement", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "displacement", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // max_speed
     raw = toml_raw_in(table, "max_speed");
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "max_speed", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "max_speed", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.max_speed)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "max_speed", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "max_speed", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
 
@@ -612,50 +899,50 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     toml_array_t *array = toml_array_in(table, "cog");
     if (array == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "cog", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "cog", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // cog.x
     raw = toml_raw_at(array, 0);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "cog[0]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "cog[0]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.cog.keys.x)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "cog[0]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "cog[0]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // cog.y
     raw = toml_raw_at(array, 1);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "cog[1]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "cog[1]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.cog.keys.y)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "cog[1]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "cog[1]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // cog.z
     raw = toml_raw_at(array, 2);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "cog[2]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "cog[2]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.cog.keys.z)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "cog[2]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "cog[2]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
 
@@ -663,50 +950,50 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     array = toml_array_in(table, "radius_of_gyration");
     if (array == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "radius_of_gyration", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "radius_of_gyration", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // radius_of_gyration.x
     raw = toml_raw_at(array, 0);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "radius_of_gyration[0]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "radius_of_gyration[0]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.r_roll)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "radius_of_gyration[0]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "radius_of_gyration[0]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // radius_of_gyration.pitch
     raw = toml_raw_at(array, 1);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "radius_of_gyration[1]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "radius_of_gyration[1]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.r_pitch)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "radius_of_gyration[1]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "radius_of_gyration[1]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // radius_of_gyration.yaw
     raw = toml_raw_at(array, 2);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "radius_of_gyration[2]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "radius_of_gyration[2]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(asv_spec.r_yaw)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "radius_of_gyration[2]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "radius_of_gyration[2]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
 
@@ -715,36 +1002,36 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     array = toml_array_in(table, "asv_position");
     if (array == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "asv_position", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "asv_position", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // asv_position.x
     raw = toml_raw_at(array, 0);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "asv_position[0]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "asv_position[0]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(origin_position.keys.x)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "asv_position[0]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "asv_position[0]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // asv_position.y
     raw = toml_raw_at(array, 1);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "asv_position[1]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "asv_position[1]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(origin_position.keys.y)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "asv_position[1]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "asv_position[1]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
 
@@ -753,8 +1040,8 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     array = toml_array_in(table, "asv_attitude");
     if (array == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "asv_attitude", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "asv_attitude", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // Extract values in table [vehicle_attitude]
@@ -763,14 +1050,14 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     raw = toml_raw_at(array, 0);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "asv_attitude[0]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "asv_attitude[0]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(heel)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "asv_attitude[0]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "asv_attitude[0]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     else
@@ -783,14 +1070,14 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     raw = toml_raw_at(array, 1);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "asv_attitude[1]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "asv_attitude[1]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(trim)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "asv_attitude[1]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "asv_attitude[1]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     else
@@ -803,14 +1090,14 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     raw = toml_raw_at(array, 2);
     if (raw == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "asv_attitude[2]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "asv_attitude[2]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     if (toml_rtod(raw, &(heading)))
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "asv_attitude[2]", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "asv_attitude[2]", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     else
@@ -826,8 +1113,8 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     toml_table_t *arrays = toml_array_in(table, "thrusters");
     if (array == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "thrusters", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "thrusters", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // get number of thrusters
@@ -842,54 +1129,54 @@ void simulation_set_input_using_file(struct Simulation* first_node,
       raw = toml_raw_at(array, 0);
       if (raw == 0)
       {
-        char* thruster_index[16];
+        char thruster_index[32];
         snprintf(thruster_index, sizeof(thruster_index), "thrusters[%d][0]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, thruster_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, thruster_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       if (toml_rtod(raw, &(thruster_position.keys.x)))
       {
-        char* thruster_index[16];
+        char thruster_index[32];
         snprintf(thruster_index, sizeof(thruster_index), "thrusters[%d][0]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_bad_value, thruster_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, thruster_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       // y
       raw = toml_raw_at(array, 1);
       if (raw == 0)
       {
-        char* thruster_index[16];
+        char thruster_index[32];
         snprintf(thruster_index, sizeof(thruster_index), "thrusters[%d][1]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, thruster_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, thruster_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       if (toml_rtod(raw, &(thruster_position.keys.y)))
       {
-        char* thruster_index[16];
+        char thruster_index[32];
         snprintf(thruster_index, sizeof(thruster_index), "thrusters[%d][1]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_bad_value, thruster_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, thruster_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       // z
       raw = toml_raw_at(array, 2);
       if (raw == 0)
       {
-        char* thruster_index[16];
+        char thruster_index[32];
         snprintf(thruster_index, sizeof(thruster_index), "thrusters[%d][2]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, thruster_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, thruster_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       if (toml_rtod(raw, &(thruster_position.keys.z)))
       {
-        char* thruster_index[16];
+        char thruster_index[32];
         snprintf(thruster_index, sizeof(thruster_index), "thrusters[%d][2]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_bad_value, thruster_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, thruster_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       thrusters[i] = thruster_new(thruster_position);
@@ -902,8 +1189,8 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     arrays = toml_array_in(table, "waypoints");
     if (arrays == 0)
     {
-      snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, "waypoints", "[asv]", n);
-      set_error_msg(&first_node->error_msg, error_buffer);
+      snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, "waypoints", "[asv]", n);
+      set_error_msg(&simulation->error_msg, error_buffer);
       return;
     }
     // get number of waypoints
@@ -917,43 +1204,43 @@ void simulation_set_input_using_file(struct Simulation* first_node,
       raw = toml_raw_at(array, 0);
       if (raw == 0)
       {
-        char* waypoint_index[16];
+        char waypoint_index[32];
         snprintf(waypoint_index, sizeof(waypoint_index), "waypoints[%d][0]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, waypoint_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, waypoint_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       if (toml_rtod(raw, &(current->waypoints[i].keys.x)))
       {
-        char* waypoint_index[16];
+        char waypoint_index[32];
         snprintf(waypoint_index, sizeof(waypoint_index), "waypoints[%d][0]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_bad_value, waypoint_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, waypoint_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       // y
       raw = toml_raw_at(array, 1);
       if (raw == 0)
       {
-        char* waypoint_index[16];
+        char waypoint_index[32];
         snprintf(waypoint_index, sizeof(waypoint_index), "waypoints[%d][1]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_missing_variable, waypoint_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_missing_variable, waypoint_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
       if (toml_rtod(raw, &(current->waypoints[i].keys.y)))
       {
-        char* waypoint_index[16];
+        char waypoint_index[32];
         snprintf(waypoint_index, sizeof(waypoint_index), "waypoints[%d][1]", i);
-        snprintf(error_buffer, sizeof(error_buffer), error_bad_value, waypoint_index, "[asv]", n);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, waypoint_index, "[asv]", n);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
     }
   }
 
   // Locate table [clock]
-  current->time_step_size = 40.0; // default value for time step size
+  double time_step_size = 40.0; // default value for time step size
   toml_table_t* table = toml_table_in(input, "clock");
   if (table != 0)
   {
@@ -962,81 +1249,76 @@ void simulation_set_input_using_file(struct Simulation* first_node,
     raw = toml_raw_in(table, "time_step_size");
     if (raw != 0)
     {
-      if (toml_rtod(raw, &current->time_step_size))
+      if (toml_rtod(raw, &time_step_size))
       {
-        snprintf(error_buffer, sizeof(error_buffer), error_bad_value, "time_step_size", "[clock]", 0);
-        set_error_msg(&first_node->error_msg, error_buffer);
+        snprintf(error_buffer, sizeof(simulation->error_msg_buffer), error_bad_value, "time_step_size", "[clock]", 0);
+        set_error_msg(&simulation->error_msg, error_buffer);
         return;
       }
     }
   }
 
+  for (int n = 0; n < count_asvs; ++n)
+  {
+    simulation->nodes[index_first_asv + n].time_step_size = time_step_size;
+  }
+
   // done reading inputs
   toml_free(input);
 }
 
-void simulation_set_input_using_asvs(struct Simulation* first_node,
+void simulation_set_input_using_asvs(struct Simulation* simulation,
                                     struct Asv** asvs,  
                                     int count_asvs,
                                     bool with_time_sync)
 {
-  if(first_node && asvs)
+  if(simulation && asvs)
   {
-    clear_error_msg(&first_node->error_msg);
-    struct Simulation* current = first_node;
-    for (int n = 0; n < count_asvs; ++n)
+    clear_error_msg(&simulation->error_msg);
+    // Set the Pointer to function for executing the simulation.
+    if(with_time_sync)
     {
-      // Create a new entry to the linked list of simulation data.
-      if(n != 0)
-      {
-        struct Simulation* previous = current;
-        // Create a new entry to the linked list.
-        current = simulation_new_node();
-        // Link it to the previous entry in the linked list.
-        previous->next = current; 
-        current->previous = previous;
-      }
+      simulation->simulation_run = simulation_spawn_nodes_with_time_sync;
+    }
+    else
+    {
+      simulation->simulation_run = simulation_spawn_nodes_without_time_sync;
+    }
 
-      // Set the Pointer to function for executing the simulation.
-      if(with_time_sync)
-      {
-        current->simulation_run = simulation_spawn_nodes_with_time_sync;
-      }
-      else
-      {
-        current->simulation_run = simulation_spawn_nodes_without_time_sync;
-      }
+    if(!simulation_reserve_nodes(simulation, simulation->count_nodes + count_asvs))
+    {
+      return;
+    }
+    for (int n = 0; n < count_asvs; ++n)
+    {
+      // Add a node for the asv.
+      struct Node* current = simulation_add_node(simulation);
 
-      // Create and initialise the sea surface
+      // Set the sea surface. Asvs may share a sea surface, which is then freed by the first node using it.
       current->asv = asvs[n];
       current->sea_surface = asv_get_sea_surface(current->asv);
+      current->owns_sea_surface = (current->sea_surface != NULL);
+      for(struct Node* node = simulation->nodes; node != current; ++node)
+      {
+        if(node->sea_surface == current->sea_surface)
+        {
+          current->owns_sea_surface = false;
+          break;
+        }
+      }
     }  
   }
-  else
-  {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-  } 
 }
 
-void simulation_set_waypoints_for_asv(struct Simulation* first_node,
+void simulation_set_waypoints_for_asv(struct Simulation* simulation,
                                       struct Asv* asv, 
                                       union Coordinates_3D* waypoints,
                                       int count_waypoints)
 {
-  if(first_node && asv)
+  if(simulation && asv && waypoints)
   {
-    clear_error_msg(&first_node->error_msg);
-    // Find the asv from the linked list
-    struct Simulation* node = NULL;
-    for(struct Simulation* current_node = first_node; current_node != NULL; current_node = current_node->next)
-    {
-      if(current_node->asv == asv)
-      {
-        // Found it. 
-        node = current_node;
-        break;
-      }
-    }
+    clear_error_msg(&simulation->error_msg);
+    struct Node* node = simulation_find_node(simulation, asv);
     if(node)
     {
       if(node->count_waypoints < count_waypoints)
@@ -1045,41 +1327,33 @@ void simulation_set_waypoints_for_asv(struct Simulation* first_node,
         free(node->waypoints);
         node->waypoints = (union Coordinates_3D*)malloc(sizeof(union Coordinates_3D)*count_waypoints);
       }
-      if(waypoints)
+      for(int i = 0; i < count_waypoints; ++i)
       {
-        for(int i = 0; i < count_waypoints; ++i)
-        {
-          node->waypoints[i] = waypoints[i];
-        }
-        node->count_waypoints = count_waypoints;
-        node->current_waypoint_index = 0;
+        node->waypoints[i] = waypoints[i];
       }
-      else
-      {
-        set_error_msg(&first_node->error_msg, error_null_pointer);
-        return;
-      } 
+      node->count_waypoints = count_waypoints;
+      node->current_waypoint_index = 0;
     }
     else
     {
-      set_error_msg(&first_node->error_msg, "Could not find the ASV.");
-      return;
+      set_error_msg(&simulation->error_msg, "Could not find the ASV.");
     }
   }
-  else
+  else if(simulation)
   {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return;
+    set_error_msg(&simulation->error_msg, error_null_pointer);
   } 
 }
 
-void simulation_set_controller(struct Simulation* first_node, double* gain_position, double* gain_heading)
+void simulation_set_controller(struct Simulation* simulation, double* gain_position, double* gain_heading)
 {
-  if(first_node && gain_position && gain_heading)
+  if(simulation && gain_position && gain_heading)
   {
-    clear_error_msg(&first_node->error_msg);
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
+    clear_error_msg(&simulation->error_msg);
+    for(int i = 0; i < simulation->count_nodes; ++i)
     {
+      struct Node* node = &(simulation->nodes[i]);
+      controller_delete(node->controller);
       node->controller = controller_new(node->asv);
       // PID controller set gain terms
       double p_position = gain_position[0];
@@ -1092,254 +1366,200 @@ void simulation_set_controller(struct Simulation* first_node, double* gain_posit
       controller_set_gains_heading(node->controller, p_heading, i_heading, d_heading);
     }
   }
-  else
+  else if(simulation)
   {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return;
+    set_error_msg(&simulation->error_msg, error_null_pointer);
   } 
 }
 
-void simulation_tune_controller(struct Simulation* first_node)
+void simulation_tune_controller(struct Simulation* simulation)
 {
-  if(first_node)
+  if(simulation && simulation->count_nodes > 0)
   {
-    clear_error_msg(&first_node->error_msg);
-    first_node->controller = controller_new(first_node->asv);
-    controller_tune(first_node->controller);
-    union Coordinates_3D k_position = controller_get_gains_position(first_node->controller);
-    union Coordinates_3D k_heading  = controller_get_gains_heading(first_node->controller);
-    // Assuming all asvs will use the controller with same gain terms. 
-    simulation_set_controller(first_node->next, k_position.array, k_heading.array);
+    clear_error_msg(&simulation->error_msg);
+    // Tune the controller of the first asv...
+    struct Controller* controller = controller_new(simulation->nodes[0].asv);
+    controller_tune(controller);
+    union Coordinates_3D k_position = controller_get_gains_position(controller);
+    union Coordinates_3D k_heading  = controller_get_gains_heading(controller);
+    controller_delete(controller);
+    // ... and assume all asvs will use the controller with same gain terms. 
+    simulation_set_controller(simulation, k_position.array, k_heading.array);
   }
-  else
-  {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return;
-  } 
 }
 
-
-
-void simulation_run_upto_waypoint(struct Simulation* first_node, char* out_dir)
+void simulation_set_count_threads(struct Simulation* simulation, int count_threads)
 {
-  if(first_node)
+  if(simulation)
   {
-    clear_error_msg(&first_node->error_msg);
-    first_node->simulation_run(first_node, out_dir);
-
-    // Check for any errors during simulation and print it. 
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
+    clear_error_msg(&simulation->error_msg);
+    if(count_threads < 0)
     {
-      if(node->error_msg)
-      {
-        fprintf(stderr, "ERROR: ASV id = %s. %s\n", node->id, node->error_msg);
-      }
+      set_error_msg(&simulation->error_msg, "Number of threads cannot be negative.");
+      return;
     }
+    simulation->count_threads = count_threads;
   }
-  else
-  {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return;
-  } 
 }
 
-void simulation_run_upto_time(struct Simulation* first_node, double max_time, char* out_dir)
+// Prints the errors, if any, of the simulation and of each node.
+static void simulation_print_errors(struct Simulation* simulation)
 {
-  if(first_node)
+  if(simulation->error_msg)
+  {
+    fprintf(stderr, "ERROR: %s\n", simulation->error_msg);
+  }
+  for(int i = 0; i < simulation->count_nodes; ++i)
   {
-    clear_error_msg(&first_node->error_msg);
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
+    struct Node* node = &(simulation->nodes[i]);
+    if(node->error_msg)
     {
-      node->max_time = max_time;
+      fprintf(stderr, "ERROR: ASV id = %s. %s\n", node->id, node->error_msg);
     }
-    simulation_run_upto_waypoint(first_node, out_dir);
   }
-  else
-  {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return;
-  } 
 }
 
-void simulation_run_a_timestep(struct Simulation* first_node)
+void simulation_run_upto_waypoint(struct Simulation* simulation, char* out_dir)
 {
-  if(first_node)
+  if(simulation && simulation->simulation_run)
   {
-    clear_error_msg(&first_node->error_msg);
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
-    {
-      simulation_run_per_node_per_time_step(first_node);
-    }
+    clear_error_msg(&simulation->error_msg);
+    simulation->simulation_run(simulation, out_dir);
     // Check for any errors during simulation and print it. 
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
+    simulation_print_errors(simulation);
+  }
+}
+
+void simulation_run_upto_time(struct Simulation* simulation, double max_time, char* out_dir)
+{
+  if(simulation)
+  {
+    clear_error_msg(&simulation->error_msg);
+    for(int i = 0; i < simulation->count_nodes; ++i)
     {
-      if(node->error_msg)
-      {
-        fprintf(stderr, "ERROR: ASV id = %s. %s\n", node->id, node->error_msg);
-      }
+      simulation->nodes[i].max_time = max_time;
     }
+    simulation_run_upto_waypoint(simulation, out_dir);
   }
-  else
-  {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return;
-  } 
 }
 
-union Coordinates_3D simulation_get_waypoint(struct Simulation* first_node, struct Asv* asv)
+void simulation_run_a_timestep(struct Simulation* simulation)
 {
-  if(first_node)
+  if(simulation)
   {
-    clear_error_msg(&first_node->error_msg);
-    // Find the asv from the linked list
-    struct Simulation* node = NULL;
-    for(struct Simulation* current_node = first_node; current_node != NULL; current_node = current_node->next)
+    clear_error_msg(&simulation->error_msg);
+    for(int i = 0; i < simulation->count_nodes; ++i)
     {
-      if(current_node->asv == asv)
+      struct Node* node = &(simulation->nodes[i]);
+      if(node->current_waypoint_index < node->count_waypoints && !node->error_msg)
       {
-        // Found it. 
-        node = current_node;
-        break;
+        if(node->buffer_index >= OUTPUT_BUFFER_SIZE)
+        {
+          // Buffer exceeded. There is no output file, so reset the buffer.
+          node->buffer_index = 0;
+        }
+        simulation_run_per_node_per_time_step(node, NULL);
+        ++(node->current_time_index);
       }
     }
-    if(node)
-    {
-      return node->waypoints[node->current_waypoint_index];
-    }
-    else
-    {
-      set_error_msg(&first_node->error_msg, "Could not find the ASV.");
-      return (union Coordinates_3D){0.0,0.0,0.0};
-    }
+    // Check for any errors during simulation and print it. 
+    simulation_print_errors(simulation);
   }
-  else
+}
+
+int simulation_get_count_asvs(struct Simulation* simulation)
+{
+  if(simulation)
   {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return (union Coordinates_3D){0.0,0.0,0.0};
-  } 
+    clear_error_msg(&simulation->error_msg);
+    return simulation->count_nodes;
+  }
+  return 0;
 }
 
-int simulation_get_count_waypoints(struct Simulation* first_node, struct Asv* asv)
+int simulation_get_asvs(struct Simulation* simulation, struct Asv** asvs)
 {
-  if(first_node)
+  if(simulation && asvs)
   {
-    clear_error_msg(&first_node->error_msg);
-    // Find the asv from the linked list
-    struct Simulation* node = NULL;
-    for(struct Simulation* current_node = first_node; current_node != NULL; current_node = current_node->next)
-    {
-      if(current_node->asv == asv)
-      {
-        // Found it. 
-        node = current_node;
-        break;
-      }
-    }
-    if(node)
-    {
-      return node->count_waypoints;
-    }
-    else
+    clear_error_msg(&simulation->error_msg);
+    for(int i = 0; i < simulation->count_nodes; ++i)
     {
-      set_error_msg(&first_node->error_msg, "Could not find the ASV.");
-      return 0;
+      asvs[i] = simulation->nodes[i].asv;
     }
+    return simulation->count_nodes;
   }
-  else
+  else if(simulation)
   {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return 0;
+    set_error_msg(&simulation->error_msg, error_null_pointer);
   } 
+  return 0;
 }
 
-union Coordinates_3D* simulation_get_waypoints(struct Simulation* first_node, struct Asv* asv)
+int simulation_get_asv_index(struct Simulation* simulation, struct Asv* asv)
 {
-  if(first_node)
+  if(simulation)
   {
-    clear_error_msg(&first_node->error_msg);
-    // Find the asv from the linked list
-    struct Simulation* node = NULL;
-    for(struct Simulation* current_node = first_node; current_node != NULL; current_node = current_node->next)
-    {
-      if(current_node->asv == asv)
-      {
-        // Found it. 
-        node = current_node;
-        break;
-      }
-    }
+    clear_error_msg(&simulation->error_msg);
+    struct Node* node = simulation_find_node(simulation, asv);
     if(node)
     {
-      return node->waypoints;
-    }
-    else
-    {
-      set_error_msg(&first_node->error_msg, "Could not find the ASV.");
-      return NULL;
+      return (int)(node - simulation->nodes);
     }
+    set_error_msg(&simulation->error_msg, "Could not find the ASV.");
   }
-  else
-  {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return NULL;
-  } 
+  return -1;
 }
 
-int simulation_get_count_asvs(struct Simulation* first_node)
+union Coordinates_3D simulation_get_waypoint_by_index(struct Simulation* simulation, int asv_index)
 {
-  if(first_node)
+  if(simulation)
   {
-    clear_error_msg(&first_node->error_msg);
-    int i = 0;
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
+    clear_error_msg(&simulation->error_msg);
+    struct Node* node = simulation_get_node(simulation, asv_index);
+    if(node && node->count_waypoints > 0)
     {
-      ++i;
+      // After the final waypoint is reached, it remains the current waypoint.
+      int i = (node->current_waypoint_index < node->count_waypoints) ? node->current_waypoint_index : node->count_waypoints - 1;
+      return node->waypoints[i];
     }
-    return i;
   }
-  else
-  {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return 0;
-  } 
+  return (union Coordinates_3D){0.0,0.0,0.0};
 }
 
-int simulation_get_asvs(struct Simulation* first_node, struct Asv** asvs)
+int simulation_get_count_waypoints_by_index(struct Simulation* simulation, int asv_index)
 {
-  if(first_node)
+  if(simulation)
   {
-    clear_error_msg(&first_node->error_msg);
-    int i = 0;
-    for(struct Simulation* node = first_node; node != NULL; node = node->next)
+    clear_error_msg(&simulation->error_msg);
+    struct Node* node = simulation_get_node(simulation, asv_index);
+    if(node)
     {
-      asvs[i++] = node->asv;
+      return node->count_waypoints;
     }
-    return i;
   }
-  else
-  {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return 0;
-  } 
+  return 0;
 }
 
-
-union Coordinates_3D simulation_get_asv_position_at(struct Simulation* first_node, struct Asv* asv, int index)
+union Coordinates_3D* simulation_get_waypoints_by_index(struct Simulation* simulation, int asv_index)
 {
-  if(first_node && asv)
+  if(simulation)
   {
-    clear_error_msg(&first_node->error_msg);
-    // Find the asv from the linked list
-    struct Simulation* node = NULL;
-    for(struct Simulation* current_node = first_node; current_node != NULL; current_node = current_node->next)
+    clear_error_msg(&simulation->error_msg);
+    struct Node* node = simulation_get_node(simulation, asv_index);
+    if(node)
     {
-      if(current_node->asv == asv)
-      {
-        // Found it. 
-        node = current_node;
-        break;
-      }
+      return node->waypoints;
     }
+  }
+  return NULL;
+}
+
+union Coordinates_3D simulation_get_asv_position_at_by_index(struct Simulation* simulation, int asv_index, int index)
+{
+  if(simulation)
+  {
+    clear_error_msg(&simulation->error_msg);
+    struct Node* node = simulation_get_node(simulation, asv_index);
     if(node)
     {
       if(index >= 0 && index < node->buffer_index)
@@ -1350,16 +1570,71 @@ union Coordinates_3D simulation_get_asv_position_at(struct Simulation* first_nod
         position.keys.z = node->buffer[index].cog_z;
         return position;
       }
+      set_error_msg(&simulation->error_msg, error_invalid_index);
     }
-    else
+  }
+  return (union Coordinates_3D){0.0,0.0,0.0};
+}
+
+int simulation_get_positions(struct Simulation* simulation, union Coordinates_3D* positions)
+{
+  if(simulation && positions)
+  {
+    clear_error_msg(&simulation->error_msg);
+    for(int i = 0; i < simulation->count_nodes; ++i)
     {
-      set_error_msg(&first_node->error_msg, "Could not find the ASV.");
-      return (union Coordinates_3D){0.0,0.0,0.0};
+      positions[i] = asv_get_position_cog(simulation->nodes[i].asv);
     }
+    return simulation->count_nodes;
   }
-  else
+  else if(simulation)
   {
-    set_error_msg(&first_node->error_msg, error_null_pointer);
-    return (union Coordinates_3D){0.0,0.0,0.0};
+    set_error_msg(&simulation->error_msg, error_null_pointer);
   } 
-}
\ No newline at end of file
+  return 0;
+}
+
+int simulation_get_current_waypoints(struct Simulation* simulation, union Coordinates_3D* waypoints)
+{
+  if(simulation && waypoints)
+  {
+    clear_error_msg(&simulation->error_msg);
+    for(int i = 0; i < simulation->count_nodes; ++i)
+    {
+      waypoints[i] = simulation_get_waypoint_by_index(simulation, i);
+    }
+    return simulation->count_nodes;
+  }
+  else if(simulation)
+  {
+    set_error_msg(&simulation->error_msg, error_null_pointer);
+  } 
+  return 0;
+}
+
+// Functions that find the asv by its pointer. These search the simulation for the 
+// asv and are kept for compatibility; the functions taking the index of the asv do not search.
+
+union Coordinates_3D simulation_get_waypoint(struct Simulation* simulation, struct Asv* asv)
+{
+  int asv_index = simulation_get_asv_index(simulation, asv);
+  return (asv_index >= 0) ? simulation_get_waypoint_by_index(simulation, asv_index) : (union Coordinates_3D){0.0,0.0,0.0};
+}
+
+int simulation_get_count_waypoints(struct Simulation* simulation, struct Asv* asv)
+{
+  int asv_index = simulation_get_asv_index(simulation, asv);
+  return (asv_index >= 0) ? simulation_get_count_waypoints_by_index(simulation, asv_index) : 0;
+}
+
+union Coordinates_3D* simulation_get_waypoints(struct Simulation* simulation, struct Asv* asv)
+{
+  int asv_index = simulation_get_asv_index(simulation, asv);
+  return (asv_index >= 0) ? simulation_get_waypoints_by_index(simulation, asv_index) : NULL;
+}
+
+union Coordinates_3D simulation_get_asv_position_at(struct Simulation* simulation, struct Asv* asv, int index)
+{
+  int asv_index = simulation_get_asv_index(simulation, asv);
+  return (asv_index >= 0) ? simulation_get_asv_position_at_by_index(simulation, asv_index, index) : (union Coordinates_3D){0.0,0.0,0.0};
+}
@@ -71,8 +71,8 @@ Scene::Scene(struct Simulation* first_node): vtkCommand{}
     min_x = (asv_position.keys.x < min_x)? asv_position.keys.x : min_x;
     min_y = (asv_position.keys.y < min_y)? asv_position.keys.y : min_y;
 
-    int count_waypoints = simulation_get_count_waypoints(first_node, asvs[i]);
-    union Coordinates_3D* waypoints = simulation_get_waypoints(first_node, asvs[i]);
+    int count_waypoints = simulation_get_count_waypoints_by_index(first_node, i);
+    union Coordinates_3D* waypoints = simulation_get_waypoints_by_index(first_node, i);
     for(int j=0; j<count_waypoints; ++j)
     {
       union Coordinates_3D waypoint = waypoints[j];
@@ -146,19 +146,22 @@ void Scene::Execute(vtkObject *caller,
   simulation_run_a_timestep(first_node);
   bool has_any_reached_final_waypoint = false;
   int count_asvs = simulation_get_count_asvs(first_node);
-  struct Asv** asvs = new struct Asv*[count_asvs];
-  simulation_get_asvs(first_node, asvs);
+  union Coordinates_3D* positions = new union Coordinates_3D[count_asvs];
+  union Coordinates_3D* waypoints = new union Coordinates_3D[count_asvs];
+  simulation_get_positions(first_node, positions);
+  simulation_get_current_waypoints(first_node, waypoints);
   for(int i = 0; i < count_asvs; ++i)
   {
-    union Coordinates_3D p1 = asv_get_position_cog(asvs[i]);
-    union Coordinates_3D p2 = simulation_get_waypoint(first_node, asvs[i]);
+    union Coordinates_3D p1 = positions[i];
+    union Coordinates_3D p2 = waypoints[i];
     double distance = sqrt((p1.keys.x-p2.keys.x)*(p1.keys.x-p2.keys.x) + (p1.keys.y-p2.keys.y)*(p1.keys.y-p2.keys.y));
     if(distance < 5.0)
     {
       has_any_reached_final_waypoint = true;
     }
   } 
-  delete[] asvs; 
+  delete[] positions; 
+  delete[] waypoints; 
 
   // stop if all reached the destination.
   if(has_any_reached_final_waypoint)
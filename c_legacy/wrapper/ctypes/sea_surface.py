@@ -78,6 +78,21 @@ class Sea_surface(ctypes.Structure):
         result = sea_surface_get_elevation(self.__c_base_object, location, ctypes.c_double(time))
         self.__check_error_throw_exception()
         return result
+
+    def get_elevations(self, locations, time):
+        '''
+        Get sea surface elevations at a set of locations for the given time.
+        :param list locations: List of Coordinates_3D at which the elevations are to be calculated. All coordinates in meter.
+        :param float time: Time for which the elevations are to be calculated. Time is measured in seconds from the start of simulation. Time should be non-negative.
+        '''
+        count_locations = len(locations)
+        c_locations = (Coordinates_3D * count_locations)(*locations)
+        c_elevations = (ctypes.c_double * count_locations)()
+        sea_surface_get_elevations = dll.dll.sea_surface_get_elevations
+        sea_surface_get_elevations.restype = None
+        sea_surface_get_elevations(self.__c_base_object, c_locations, ctypes.c_int(count_locations), ctypes.c_double(time), c_elevations)
+        self.__check_error_throw_exception()
+        return list(c_elevations)
     
     def get_count_wave_spectral_directions(self):
         '''
@@ -10,6 +10,7 @@ cdef extern from "sea_surface.h":
     void sea_surface_delete(Sea_surface* sea_surface)
     char* sea_surface_get_error_msg(Sea_surface* sea_surface)
     double sea_surface_get_elevation(Sea_surface* sea_surface, Coordinates_3D location, double time)
+    void sea_surface_get_elevations(Sea_surface* sea_surface, Coordinates_3D* locations, int count_locations, double time, double* elevations)
     int sea_surface_get_count_component_waves(Sea_surface* sea_surface)
     double sea_surface_get_min_spectral_frequency(Sea_surface* sea_surface)
     double sea_surface_get_max_spectral_frequency(Sea_surface* sea_surface)
@@ -22,6 +23,7 @@ cdef class py_Sea_surface:
     cdef Sea_surface* _c_object
     cdef void __check_error_throw_exception(self)
     cdef double get_elevation(self, Coordinates_3D location, double time)
+    cdef void get_elevations(self, Coordinates_3D* locations, int count_locations, double time, double* elevations)
     cdef int get_count_component_waves(self)
     cdef double get_min_spectral_frequency(self)
     cdef double get_max_spectral_frequency(self)
@@ -1,3 +1,4 @@
+from libc.stdlib cimport malloc, free
 from geometry cimport py_Coordinates_3D
 from regular_wave cimport py_Regular_wave
 
@@ -38,6 +39,44 @@ cdef class py_Sea_surface:
         '''
         return self.get_elevation(location._c_object, time)
 
+    cdef void get_elevations(self, Coordinates_3D* locations, int count_locations, double time, double* elevations):
+        '''
+        Get sea surface elevations at a set of locations for the given time.
+        :param Coordinates_3D* locations: Array of count_locations locations. All coordinates in meter.
+        :param int count_locations: Number of locations.
+        :param float time: Time for which the elevations are to be calculated. Time is measured in seconds from the start of simulation. Time should be non-negative.
+        :param double* elevations: Array of count_locations values to which the elevation, in meter, at each location is written.
+        '''
+        sea_surface_get_elevations(self._c_object, locations, count_locations, time, elevations)
+        self.__check_error_throw_exception()
+
+    def py_get_elevations(self, list py_locations, double time) -> list:
+        '''
+        Get sea surface elevations at a set of locations for the given time.
+        :param list locations: List of Coordinates_3D at which the elevations are to be calculated. All coordinates in meter.
+        :param float time: Time for which the elevations are to be calculated. Time is measured in seconds from the start of simulation. Time should be non-negative.
+        '''
+        cdef int count_locations = len(py_locations)
+        if count_locations == 0:
+            return []
+        cdef Coordinates_3D* c_locations = <Coordinates_3D*>malloc(count_locations * sizeof(Coordinates_3D))
+        cdef double* c_elevations = <double*>malloc(count_locations * sizeof(double))
+        if c_locations == NULL or c_elevations == NULL:
+            free(c_locations)
+            free(c_elevations)
+            raise MemoryError()
+        cdef int i = 0
+        cdef py_Coordinates_3D py_location
+        try:
+            for i in range(count_locations):
+                py_location = py_locations[i]
+                c_locations[i] = py_location._c_object
+            self.get_elevations(c_locations, count_locations, time, c_elevations)
+            return [c_elevations[i] for i in range(count_locations)]
+        finally:
+            free(c_locations)
+            free(c_elevations)
+
     cdef int get_count_component_waves(self):
         '''
         Get the number of regular component waves.
@@ -1,8 +1,15 @@
 #pragma once
 
 #include "geometry.h"
+#include "integration.h"
+#include "matrix_structure.h"
 #include "sea_surface.h"
+#include "wave_force_schedule.h"
 #include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 #include <memory>
 
@@ -28,18 +35,273 @@ namespace ASVLite {
 
 
 
+    /**
+     * @brief Empirical hull coefficients shared by the single-vehicle and batched ASV models.
+     */
+    namespace Hydrodynamics {
+
+        /** @brief Lookup table of (ratio, coefficient) pairs used for linear interpolation. */
+        template<size_t S>
+        using CoefficientTable = std::array<std::pair<double, double>, S>;
+
+        /**
+         * @brief Added mass coefficient against length-to-breadth ratio for an elliptical waterplane.
+         * @ref DNVGL-RP-N103 Table A-2 (page 209).
+         */
+        constexpr CoefficientTable<12> ADDED_MASS_COEFF_TABLE {{
+            {std::numeric_limits<double>::infinity(), 1.0},
+            {14.3, 0.991},
+            {12.8, 0.989},
+            {10.0, 0.984},
+            {7.0, 0.972},
+            {6.0, 0.964},
+            {5.0, 0.952},
+            {4.0, 0.933},
+            {3.0, 0.9},
+            {2.0, 0.826},
+            {1.5, 0.758},
+            {1.0, 0.637}
+        }};
+
+        /**
+         * @brief Drag coefficient against d/l ratio for flow parallel to an elliptical cross-section.
+         * @ref DNVGL-RP-N103 Table B-1 (page 215).
+         */
+        constexpr CoefficientTable<5> DRAG_COEFF_PARALLEL_FLOW_TABLE {{
+            {0.125, 0.22},
+            {0.25, 0.3},
+            {0.5, 0.6},
+            {1.0, 1.0},
+            {2.0, 1.6},
+        }};
+
+        /**
+         * @brief Drag coefficient against b/h ratio for flow perpendicular to a rectangular cross-section.
+         * @ref DNVGL-RP-N103 Table B-2 (page 217).
+         */
+        constexpr CoefficientTable<4> DRAG_COEFF_PERPENDICULAR_FLOW_TABLE {{
+            {1.0, 1.16},
+            {5.0, 1.2},
+            {10.0, 1.5},
+            {std::numeric_limits<double>::infinity(), 1.9},
+        }};
+
+
+        /**
+         * @brief Linearly interpolates a coefficient from a lookup table.
+         * 
+         * @param table Table of (ratio, coefficient) pairs.
+         * @param ratio Ratio at which the coefficient is required.
+         * @return double Interpolated coefficient, or -1 if no interval of the table contains the ratio.
+         * 
+         * @note Ratios beyond the first or the last entry of the table return the coefficient of that entry.
+         */
+        template<size_t S>
+        constexpr double interpolate_coefficient(const CoefficientTable<S>& table, const double ratio) {
+            // Check if ratio is within bounds
+            if (ratio >= table.front().first) return table.front().second;
+            if (ratio <= table.back().first) return table.back().second;
+            // Find the correct interval and interpolate
+            for (size_t i = 0; i < table.size() - 1; ++i) {
+                if (ratio <= table[i].first && ratio >= table[i + 1].first) {
+                    const double ratio1 = table[i].first; 
+                    const double ratio2 = table[i + 1].first;
+                    const double C1 = table[i].second; 
+                    const double C2 = table[i + 1].second;
+                    return C1 + (C2 - C1) * ((ratio - ratio1) / (ratio2 - ratio1));
+                }
+            }
+            return -1; // Should not reach here
+        }
+
+
+        /**
+         * @brief Computes the submerged volume of the ASV based on its submersion depth.
+         * 
+         * Assumes the submerged portion of the ASV is shaped as a hemi-ellipsoid. The submersion 
+         * depth must be negative (i.e., below the waterline) and is clamped between 0 and -D.
+         * 
+         * @param spec ASV geometric specifications.
+         * @param submersion_depth Vertical distance from the waterline to the ASV's lowest point (in meters, should be negative).
+         * @return double Submerged volume in cubic meters (m3).
+         */
+        constexpr double get_submerged_volume(const AsvSpecification& spec, const double submersion_depth) { // NOTE: submerged depth should be -ve.
+            // Assuming a hemi-ellipsoid shape for the submerged part of the ASV
+            const double d = -std::clamp(submersion_depth, -spec.D, 0.0);
+            double volume = M_PI/6.0 * spec.L_wl * spec.B_wl * d * (3.0 - d/spec.D);
+            return volume;
+        }
+
+
+        /**
+         * @brief Computes the added mass coefficient for the ASV based on its length-to-breadth ratio.
+         * 
+         * The coefficient is estimated using linear interpolation from a lookup table 
+         * derived from DNVGL-RP-N103 (Table A-2, page 209), assuming an elliptical waterplane shape.
+         * 
+         * @param spec ASV geometric specifications.
+         * @return double Added mass coefficient (dimensionless).
+         * 
+         * @note If the length-to-breadth ratio is outside the tabulated range, the function returns 
+         *       the nearest available value. The table assumes idealised hull geometries.
+         */
+        constexpr double get_added_mass_coeff(const AsvSpecification& spec) {
+            return interpolate_coefficient(ADDED_MASS_COEFF_TABLE, spec.L_wl / spec.B_wl);
+        }
+
+
+        /**
+         * @brief Estimates the drag coefficient for flow parallel to a submerged body's major axis.
+         * 
+         * The coefficient is determined by interpolating values from DNVGL-RP-N103 (Table B-1, page 215),
+         * assuming the body has an elliptical cross-section. The function uses the ratio of the
+         * dimension perpendicular to the flow (`d`) and the dimension along the flow (`l`).
+         * 
+         * @param l Length of the body along the direction of flow (in meters).
+         * @param d Characteristic dimension perpendicular to the flow (in meters).
+         * 
+         * @return double Drag coefficient for parallel flow (dimensionless).
+         * 
+         * @note If the d/l ratio falls outside the tabulated range, the closest boundary value is returned.
+         */
+        constexpr double get_drag_coefficient_parallel_flow(const double l, const double d) {
+            return interpolate_coefficient(DRAG_COEFF_PARALLEL_FLOW_TABLE, d / l);
+        }
+
+        
+        /**
+         * @brief Estimates the drag coefficient for flow perpendicular to a submerged body's major axis.
+         * 
+         * The coefficient is determined using values from DNVGL-RP-N103 (Table B-2, page 217),
+         * assuming a rectangular cross-section. It is based on the ratio of the longer edge (`b`)
+         * to the shorter edge (`h`) of the body’s cross-section.
+         * 
+         * @param b Length of the longer edge perpendicular to flow (in meters).
+         * @param h Length of the shorter edge perpendicular to flow (in meters).
+         * 
+         * @return double Drag coefficient for perpendicular flow (dimensionless).
+         * 
+         * @note If the b/h ratio falls outside the table range, the nearest boundary value is returned.
+         */
+        constexpr double get_drag_coefficient_prependicular_flow(const double b, const double h) { // b --> longer edge, h --> short edge.
+            return interpolate_coefficient(DRAG_COEFF_PERPENDICULAR_FLOW_TABLE, b / h);
+        }
+
+    }
+
+
+
+    /**
+     * @brief Hull properties of an ASV that depend only on its AsvSpecification.
+     * 
+     * These are computed once when a vehicle is constructed, so the per-step dynamics do not repeat
+     * the table interpolations or the inertia calculations. Terms that also depend on the submersion
+     * depth or the encounter frequency are stored as factors to be multiplied by that quantity.
+     */
+    struct AsvHullCoefficients {
+
+        /**
+         * @brief Computes the hull coefficients of an ASV.
+         * 
+         * @param spec ASV geometric specifications.
+         * 
+         * @throws std::runtime_error If the computed added mass coefficient is invalid.
+         */
+        constexpr explicit AsvHullCoefficients(const AsvSpecification& spec) :
+        submerged_volume {Hydrodynamics::get_submerged_volume(spec, -spec.T)},
+        mass {submerged_volume * Constants::SEA_WATER_DENSITY},
+        // Moment of inertia for angular motions considering an elliptical waterplane.
+        I_roll  {(1.0 / 20.0) * mass * (spec.B_wl*spec.B_wl + spec.T*spec.T)},
+        I_pitch {(1.0 / 20.0) * mass * (spec.L_wl*spec.L_wl + spec.T*spec.T)},
+        I_yaw   {(1.0 / 20.0) * mass * (spec.L_wl*spec.L_wl + spec.B_wl*spec.B_wl)},
+        weight {submerged_volume * Constants::SEA_WATER_DENSITY * Constants::G},
+        C_linear {Hydrodynamics::get_added_mass_coeff(spec)},
+        added_mass_heave_factor {C_linear * Constants::SEA_WATER_DENSITY * M_PI/6.0 * spec.B_wl*spec.B_wl * spec.L_wl},
+        added_mass_roll_factor  {C_angular * Constants::SEA_WATER_DENSITY * submerged_volume * (spec.B_wl*spec.B_wl + spec.T*spec.T)/5.0},
+        added_mass_pitch_factor {C_angular * Constants::SEA_WATER_DENSITY * submerged_volume * (spec.L_wl*spec.L_wl + spec.T*spec.T)/5.0},
+        // Ref: Recommended practices DNVGL-RP-N103 Modelling and analysis of marine
+        // operations. Edition July 2017. Appendix B Table B-1, B-2.
+        C_surge_factor {0.5 * Constants::SEA_WATER_DENSITY * Hydrodynamics::get_drag_coefficient_parallel_flow(spec.L_wl, spec.B_wl) * spec.B_wl},
+        C_sway_factor  {0.5 * Constants::SEA_WATER_DENSITY * Hydrodynamics::get_drag_coefficient_parallel_flow(spec.B_wl, spec.L_wl) * spec.L_wl},
+        C_heave {0.5 * Constants::SEA_WATER_DENSITY * Hydrodynamics::get_drag_coefficient_prependicular_flow(spec.L_wl, spec.B_wl) * spec.L_wl * spec.B_wl},
+        // Handbook of Marin Craft Hydrodynamics and motion control, page 125
+        C_roll  {1.5 * Constants::SEA_WATER_DENSITY * spec.B_wl*spec.B_wl*spec.B_wl * spec.T},
+        C_pitch {1.5 * Constants::SEA_WATER_DENSITY * spec.L_wl*spec.L_wl*spec.L_wl * spec.T},
+        C_yaw   {1.5 * Constants::SEA_WATER_DENSITY * spec.B_wl*spec.B_wl*spec.B_wl * spec.L_wl} {
+            if(C_linear < 0.0) {
+                throw std::runtime_error("Invalid added mass coefficient");
+            }
+        }
+
+        /** @brief Added mass coefficient for angular motions (dimensionless). */
+        static constexpr double C_angular = 0.2;
+
+        /** @brief Submerged volume at the design draught (m3). */
+        const double submerged_volume;
+
+        /** @brief Rigid body mass (kg). */
+        const double mass;
+
+        /** @brief Moment of inertia in roll (kg·m2). */
+        const double I_roll;
+
+        /** @brief Moment of inertia in pitch (kg·m2). */
+        const double I_pitch;
+
+        /** @brief Moment of inertia in yaw (kg·m2). */
+        const double I_yaw;
+
+        /** @brief Weight of the ASV (N). */
+        const double weight;
+
+        /** @brief Added mass coefficient for linear motions, from DNVGL-RP-N103 Table A-2 (dimensionless). */
+        const double C_linear;
+
+        /** @brief Heave added mass per unit mean square encounter frequency. */
+        const double added_mass_heave_factor;
+
+        /** @brief Roll added mass per unit mean square encounter frequency. */
+        const double added_mass_roll_factor;
+
+        /** @brief Pitch added mass per unit mean square encounter frequency. */
+        const double added_mass_pitch_factor;
+
+        /** @brief Surge drag coefficient per meter of submersion depth. */
+        const double C_surge_factor;
+
+        /** @brief Sway drag coefficient per meter of submersion depth. */
+        const double C_sway_factor;
+
+        /** @brief Heave drag coefficient. */
+        const double C_heave;
+
+        /** @brief Roll drag coefficient. */
+        const double C_roll;
+
+        /** @brief Pitch drag coefficient. */
+        const double C_pitch;
+
+        /** @brief Yaw drag coefficient. */
+        const double C_yaw;
+    };
+
+
+
     /**
      * @brief Structure representing the rigid body dynamics of an Autonomous Surface Vehicle (ASV).
      * 
      * This struct holds time, pose, hydrodynamic properties, and dynamic state variables used for 
      * simulating the 6-DOF motion of the ASV in a marine environment.
+     * 
+     * @tparam Structure Structure policy of the mass, damping and stiffness matrices (see MatrixStructure).
      */
+    template<typename Structure = MatrixStructure::Diagonal>
     struct AsvDynamics {
         /** @brief Simulation time (in seconds). */
         double time = 0.0;
 
         /** @brief Time step size (in milliseconds). */
-        const double time_step_size = 40;
+        double time_step_size = 40;
 
         /**
          * @brief Position of the ASV in 3D space (in meters).
@@ -54,17 +316,26 @@ namespace ASVLite {
          */
         Geometry::Coordinates3D attitude;
 
+        /** @brief Attitude as a unit quaternion, rotating vectors from the body-fixed frame to the world frame.
+         * @note Composed from attitude in the intrinsic Z-Y-X rotation sequence, with yaw w.r.t East, and 
+         * updated with it (see Asv::set_pose()).
+         */
+        Eigen::Quaterniond orientation = Eigen::Quaterniond::Identity();
+
         /** @brief Depth of submersion of the ASV (in meters). */
         double submersion_depth;
 
+        /** @brief Vertical velocity of the sea surface at the position of the ASV (in m/s). */
+        double sea_surface_velocity = 0.0;
+
         /** @brief Mass and added mass matrix (6×6) in kilograms. */
-        Eigen::Matrix<double, 6, 6> M = Eigen::Matrix<double, 6, 6>::Zero();
+        Structure M;
 
         /** @brief Damping (drag) coefficient matrix (6×6). */
-        Eigen::Matrix<double, 6, 6> C = Eigen::Matrix<double, 6, 6>::Zero();
+        Structure C;
 
         /** @brief Hydrostatic stiffness matrix (6×6). */
-        Eigen::Matrix<double, 6, 6> K = Eigen::Matrix<double, 6, 6>::Zero();
+        Structure K;
 
         /** @brief Displacement (deflection) in body-fixed frame (6×1). */
         Eigen::Matrix<double, 6, 1> X = Eigen::Matrix<double, 6, 1>::Zero();
@@ -93,12 +364,59 @@ namespace ASVLite {
 
 
 
+    /**
+     * @brief Snapshot of the state of an Asv, to branch rollouts from or to reset a vehicle without reconstructing it.
+     * 
+     * Holds everything of an Asv that changes after construction: the dynamics, the sea surface, the ocean current, 
+     * the surge and sway halt, the integration scheme and the wave force schedule, but not the specification and the 
+     * hull coefficients derived from it. The sea surface is shared by pointer and not copied, so a snapshot is a few 
+     * hundred bytes whatever the number of component waves, saving or restoring one is a fixed-size copy, and 
+     * snapshots are copy-assignable, to be kept in containers.
+     * 
+     * @tparam N, Trig, Real, Structure, Integrator The template parameters of the Asv.
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double, typename Structure = MatrixStructure::Diagonal, 
+             typename Integrator = Integration::SemiImplicitEuler> 
+    struct AsvState {
+        /** @brief Dynamics and state variables of the ASV. */
+        AsvDynamics<Structure> dynamics;
+
+        /** @brief Sea surface of the ASV, shared with the ASV and not owned by the snapshot. */
+        const SeaSurface<N, Trig, Real>* sea_surface;
+
+        /** @brief Zonal and meridional velocities of the ocean current (in m/s). */
+        std::pair<double, double> ocean_current;
+
+        /** @brief Flag to halt surge and sway motions of the ASV. */
+        bool halt_surge_and_sway;
+
+        /** @brief Time integration scheme, with its state, e.g. the sub-step size of Integration::Adaptive. */
+        Integrator integrator;
+
+        /** @brief Rate of the wave force and added mass updates, and the last updates. */
+        WaveForceSchedule<Eigen::Matrix<double, 6, 1>, Eigen::Vector3d> wave_force_schedule;
+    };
+
+
+
     /**
      * @brief Represents an Autonomous Surface Vehicle (ASV) operating in a sea environment.
      * 
-     * @tparam N Number of regular component waves used to model the wave spectrum.
+     * @tparam N Number of regular component waves used to model the wave spectrum, or DYNAMIC to match the sea surface at run time.
+     * @tparam Trig Trigonometry policy used by the sea surface and the wave force kernels 
+     *         (see Trigonometry::Exact and Trigonometry::Fast).
+     * @tparam Real Scalar type in which the component waves and the wave forces are evaluated. With 
+     *         float the per-component sums run at twice the SIMD width, while the position, attitude, 
+     *         velocity, time and the integration remain in double precision.
+     * @tparam Structure Structure policy of the mass, damping and stiffness matrices. MatrixStructure::Diagonal 
+     *         for the uncoupled model, or MatrixStructure::Coupled to carry couplings within the longitudinal 
+     *         and lateral degrees of freedom.
+     * @tparam Integrator Time integration scheme (see Integration). Integration::SemiImplicitEuler, the original 
+     *         scheme, by default. Integration::RungeKutta4 and Integration::Adaptive keep the trajectory error 
+     *         small at time steps several times larger, for long transits.
      */
-    template<size_t N> 
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double, typename Structure = MatrixStructure::Diagonal, 
+             typename Integrator = Integration::SemiImplicitEuler> 
     class Asv {
 
         public:
@@ -113,17 +431,30 @@ namespace ASVLite {
              * @param sea_surface Pointer to the irregular sea surface model (must not be nullptr).
              * @param position Initial position of the ASV on the sea surface (in meters).
              * @param attitude Initial attitude of the ASV (roll, pitch, yaw in radians, yaw is w.r.t. geographic north).
+             * @param integrator Time integration scheme, e.g. Integration::Adaptive with a tolerance.
              * 
              * @throws std::invalid_argument if sea_surface is a nullptr.
+             * @throws std::runtime_error If the computed added mass coefficient is invalid.
              */
             Asv(const AsvSpecification& spec, 
-                const SeaSurface<N>* sea_surface, 
+                const SeaSurface<N, Trig, Real>* sea_surface, 
                 const Geometry::Coordinates3D& position, 
-                const Geometry::Coordinates3D& attitude) :
-            spec {spec} {
+                const Geometry::Coordinates3D& attitude,
+                const Integrator& integrator = Integrator()) :
+            spec {spec},
+            hull {spec},
+            integrator {integrator} {
                 if(sea_surface == nullptr) {
                     throw std::invalid_argument("Sea surface cannot be nullptr.");
                 }
+                // Terms of the mass and drag matrices that depend only on the hull.
+                dynamics.M.set(0, 0, hull.mass);
+                dynamics.M.set(1, 1, hull.mass);
+                dynamics.M.set(5, 5, hull.I_yaw);
+                dynamics.C.set(2, 2, hull.C_heave);
+                dynamics.C.set(3, 3, hull.C_roll);
+                dynamics.C.set(4, 4, hull.C_pitch);
+                dynamics.C.set(5, 5, hull.C_yaw);
                 this->sea_surface = sea_surface;
                 // Place the asv vertically in the correct position W.R.T sea_surface
                 dynamics.position = position;
@@ -132,33 +463,64 @@ namespace ASVLite {
                 dynamics.attitude.keys.y = Geometry::normalise_angle_PI(attitude.keys.y);
                 // Note: yaw is provided as w.r.t North. Chage it to w.r.t East (x-axis) so as to match the intrinsic Z-Y-X rotation sequence.
                 dynamics.attitude.keys.z = Geometry::switch_angle_frame(attitude.keys.z);
+                set_orientation();
+                set_encounter_frequency();
             }
             
 
             /**
              * @brief Advances the ASV simulation by one time step using the specified thrust input.
              * 
+             * The thrust is held constant over the time step.
+             * 
              * @param thrust_position Point of thrust application in body-fixed coordinates.
              * @param thrust_magnitude Vector representing the magnitude and direction of applied thrust.
              */
             void step_simulation(const Geometry::Coordinates3D& thrust_position, const Geometry::Coordinates3D& thrust_magnitude) {
-                // Advance time
-                dynamics.time += dynamics.time_step_size/1000.0; // seconds
-                // Update submersion depth based on the ASV's vertical position relative to the current sea surface elevation and draught.
-                dynamics.submersion_depth = (dynamics.position.keys.z - spec.T) - sea_surface->get_elevation(dynamics.position, dynamics.time);
-                // Update vehicle dynamics
-                set_mass();
-                set_wave_force();
-                set_thrust(thrust_position, thrust_magnitude);
-                set_drag_force();
-                set_restoring_force();
-                set_net_force();
-                set_acceleration();
-                set_velocity();
-                set_deflection();
-                set_pose();
+                this->thrust_position = thrust_position;
+                this->thrust_magnitude = thrust_magnitude;
+                integrator.step(*this, dynamics.time_step_size/1000.0); // seconds
+            }
+
+
+            /**
+             * @brief Returns the state vector of the ASV (see Integration::State).
+             */
+            Integration::State get_state() const {
+                Integration::State state;
+                state << dynamics.position.keys.x, dynamics.position.keys.y, dynamics.position.keys.z,
+                         dynamics.attitude.keys.x, dynamics.attitude.keys.y, dynamics.attitude.keys.z,
+                         dynamics.V;
+                return state;
+            }
+
+
+            /**
+             * @brief Returns a snapshot of the state of the ASV (see AsvState).
+             */
+            AsvState<N, Trig, Real, Structure, Integrator> save_state() const {
+                return {dynamics, sea_surface, ocean_current, halt_surge_and_sway, integrator, wave_force_schedule};
+            }
+
+
+            /**
+             * @brief Returns the ASV to the state of a snapshot, e.g. to the start of an episode or a branch of a search tree.
+             * 
+             * The simulation continues from the snapshot exactly as it did from the time the snapshot was saved.
+             * 
+             * @param state Snapshot saved from this ASV or from another ASV with the same specification.
+             */
+            void restore_state(const AsvState<N, Trig, Real, Structure, Integrator>& state) {
+                dynamics = state.dynamics;
+                sea_surface = state.sea_surface;
+                ocean_current = state.ocean_current;
+                halt_surge_and_sway = state.halt_surge_and_sway;
+                integrator = state.integrator;
+                wave_force_schedule = state.wave_force_schedule;
+                is_rotation_matrix_current = false;
+                set_encounter_frequency();
             }
-            
+
 
             /**
              * @brief Updates the ASV to operate under a new sea state.
@@ -171,7 +533,7 @@ namespace ASVLite {
              * 
              * @throws std::invalid_argument if the provided sea_surface is a nullptr.
              */
-            void set_sea_state(const SeaSurface<N>* sea_surface) { 
+            void set_sea_state(const SeaSurface<N, Trig, Real>* sea_surface) { 
                 if(sea_surface == nullptr) {
                     throw std::invalid_argument("Sea surface cannot be nullptr.");
                 }
@@ -179,6 +541,8 @@ namespace ASVLite {
                 const double vertical_position_error = sea_surface->get_elevation(dynamics.position, dynamics.time) - dynamics.position.keys.z;
                 // set the sea_surface for the ASV
                 this->sea_surface = sea_surface;
+                wave_force_schedule.reset();
+                set_encounter_frequency();
                 // Place the asv vertically in the correct position W.R.T new sea_surface
                 dynamics.position.keys.z = sea_surface->get_elevation(dynamics.position, dynamics.time) + vertical_position_error;
             }
@@ -221,7 +585,7 @@ namespace ASVLite {
              * 
              * @return Pointer to the current SeaSurface instance.
              */
-            const SeaSurface<N>* get_sea_surface() const {
+            const SeaSurface<N, Trig, Real>* get_sea_surface() const {
                 return sea_surface;
             }
 
@@ -251,6 +615,19 @@ namespace ASVLite {
             }
 
 
+            /**
+             * @brief Returns the current attitude of the ASV as a unit quaternion.
+             * 
+             * The quaternion rotates vectors from the body-fixed frame to the world frame, with yaw w.r.t East
+             * (see AsvDynamics::orientation).
+             * 
+             * @return Eigen::Quaterniond Attitude quaternion.
+             */
+            Eigen::Quaterniond get_orientation() const {
+                return dynamics.orientation;
+            }
+
+
             /**
              * @brief Returns the submersion depth of the ASV's lowest point relative to the sea surface.
              * 
@@ -284,6 +661,59 @@ namespace ASVLite {
             }
 
 
+            /**
+             * @brief Sets the time step size of the simulation.
+             * 
+             * Steps much larger than the default 40 ms need Integration::RungeKutta4 or Integration::Adaptive
+             * to keep the trajectory error small.
+             * 
+             * @param time_step_size Time step size in milliseconds (must be positive).
+             * 
+             * @throws std::invalid_argument if time_step_size is not positive.
+             */
+            void set_time_step_size(const double time_step_size) {
+                if(time_step_size <= 0.0) {
+                    throw std::invalid_argument("Time step size must be positive.");
+                }
+                dynamics.time_step_size = time_step_size;
+            }
+
+
+            /**
+             * @brief Sets the interval between computations of the wave force and the added mass.
+             * 
+             * In between, both are extrapolated from the last two computations while the hydrostatics, drag 
+             * and integration run every time step (see WaveForceSchedule). The interval is capped at 
+             * WaveForceSchedule::MAX_ENCOUNTER_PERIOD_FRACTION of the shortest encounter period, so it only 
+             * removes cost when the time step is fine compared to the encounter periods. The trajectory still 
+             * drifts from that of the every-step computation over long runs.
+             * 
+             * @param update_interval Interval in milliseconds (must be non-negative). Zero, the default, to compute 
+             *        them at every evaluation.
+             * 
+             * @throws std::invalid_argument if update_interval is negative.
+             */
+            void set_wave_force_update_interval(const double update_interval) {
+                wave_force_schedule.set_update_interval(update_interval);
+            }
+
+
+            /**
+             * @brief Returns the interval between computations of the wave force and the added mass (in milliseconds).
+             */
+            double get_wave_force_update_interval() const {
+                return wave_force_schedule.get_update_interval();
+            }
+
+
+            /**
+             * @brief Returns the time integration scheme of the ASV.
+             */
+            const Integrator& get_integrator() const {
+                return integrator;
+            }
+
+
             /**
              * @brief Returns the wave-induced force acting on the ASV at the current simulation time.
              * 
@@ -429,172 +859,119 @@ namespace ASVLite {
 
         private:
 
-            /**
-             * @brief Computes the wave encounter frequency for a moving ASV.
-             * 
-             * Calculates the frequency at which the ASV encounters each wave component,
-             * accounting for vehicle speed and relative wave heading.
-             * 
-             * @param asv_speed Forward speed of the ASV (in m/s).
-             * @param wave_freq Vector of wave frequencies (in Hz).
-             * @param relative_wave_heading Vector of relative wave headings (in radians) with respect to the ASV's heading.
-             * 
-             * @return Eigen::Vector<double, N> Encounter frequencies (in Hz) for each wave component.
-             */
-            Eigen::Vector<double, N> get_encounter_frequency(double asv_speed, Eigen::Vector<double, N> wave_freq, Eigen::Vector<double, N> relative_wave_heading) {
-                return wave_freq.array() - (wave_freq.array().square()/ASVLite::Constants::G) * asv_speed * relative_wave_heading.array().cos();
-            }
+            /** @brief The integration scheme advances the ASV through set_dynamics(), set_state() and get_state_derivative(). */
+            friend Integrator;
 
 
             /**
-             * @brief Computes the submerged volume of the ASV based on its submersion depth.
+             * @brief Sets the simulation time and computes the forces and the acceleration of the ASV at its current state.
              * 
-             * Assumes the submerged portion of the ASV is shaped as a hemi-ellipsoid. The submersion 
-             * depth must be negative (i.e., below the waterline) and is clamped between 0 and -D.
+             * Uses the thrust of the current time step (see step_simulation()).
              * 
-             * @param submersion_depth Vertical distance from the waterline to the ASV's lowest point (in meters, should be negative).
-             * @return double Submerged volume in cubic meters (m3).
+             * @param time Time in seconds since the start of the simulation.
              */
-            double get_submerged_volume(const double submersion_depth) const { // NOTE: submerged depth should be -ve.
-                // Assuming a hemi-ellipsoid shape for the submerged part of the ASV
-                const double d = -std::clamp(submersion_depth, -spec.D, 0.0);
-                double volume = M_PI/6.0 * spec.L_wl * spec.B_wl * d * (3.0 - d/spec.D);
-                return volume;
+            void set_dynamics(const double time) {
+                dynamics.time = time;
+                // Update submersion depth based on the ASV's vertical position relative to the current sea surface elevation and draught.
+                // The sea surface velocity for the heave drag comes from the same evaluation.
+                const SurfaceKinematics surface = sea_surface->get_surface_kinematics(dynamics.position, dynamics.time);
+                dynamics.submersion_depth = (dynamics.position.keys.z - spec.T) - surface.elevation;
+                dynamics.sea_surface_velocity = surface.vertical_velocity;
+                // Update vehicle dynamics. The wave force and added mass are computed at the rate of the wave force 
+                // schedule and extrapolated in between.
+                if(wave_force_schedule.is_update_due(dynamics.time)) {
+                    set_encounter_frequency();
+                    set_mass();
+                    set_wave_force();
+                    wave_force_schedule.add_update(dynamics.time, dynamics.F_wave, Eigen::Vector3d(dynamics.M(2, 2), dynamics.M(3, 3), dynamics.M(4, 4)), 
+                                                   encounter_freq.abs().maxCoeff());
+                } else {
+                    const Eigen::Vector3d mass = wave_force_schedule.get_mass(dynamics.time);
+                    dynamics.M.set(2, 2, mass(0));
+                    dynamics.M.set(3, 3, mass(1));
+                    dynamics.M.set(4, 4, mass(2));
+                    dynamics.F_wave = (dynamics.submersion_depth < 0.0) ? wave_force_schedule.get_force(dynamics.time) : Eigen::Matrix<double, 6, 1>::Zero();
+                }
+                set_thrust(thrust_position, thrust_magnitude);
+                set_drag_force();
+                set_restoring_force();
+                set_net_force();
+                set_acceleration();
             }
 
 
             /**
-             * @brief Computes the added mass coefficient for the ASV based on its length-to-breadth ratio.
-             * 
-             * The coefficient is estimated using linear interpolation from a lookup table 
-             * derived from DNVGL-RP-N103 (Table A-2, page 209), assuming an elliptical waterplane shape.
+             * @brief Moves the ASV to a state and a time.
              * 
-             * @return double Added mass coefficient (dimensionless).
+             * The attitude angles are normalised, and surge and sway velocities are zeroed if halted.
              * 
-             * @note If the length-to-breadth ratio is outside the tabulated range, the function returns 
-             *       the nearest available value. The table assumes idealised hull geometries.
+             * @param state State vector (see Integration::State).
+             * @param time Time in seconds since the start of the simulation.
              */
-            double get_added_mass_coeff() const {
-                // Ref: DNVGL-RP-N103 Table A-2 (page 209)
-                // Waterplane is assumed to be elliptical.
-                // Define the table of b/a and CA values
-                std::vector<std::pair<double, double>> table = {
-                    {std::numeric_limits<double>::infinity(), 1.0},
-                    {14.3, 0.991},
-                    {12.8, 0.989},
-                    {10.0, 0.984},
-                    {7.0, 0.972},
-                    {6.0, 0.964},
-                    {5.0, 0.952},
-                    {4.0, 0.933},
-                    {3.0, 0.9},
-                    {2.0, 0.826},
-                    {1.5, 0.758},
-                    {1.0, 0.637}
-                };
-                // Check if ba is within bounds
-                const double ba = spec.L_wl / spec.B_wl;
-                if (ba >= table.front().first) return table.front().second;
-                if (ba <= table.back().first) return table.back().second;
-                // Find the correct interval and interpolate
-                for (size_t i = 0; i < table.size() - 1; ++i) {
-                    if (ba <= table[i].first && ba >= table[i + 1].first) {
-                        const double ba1 = table[i].first; 
-                        const double ba2 = table[i + 1].first;
-                        const double CA1 = table[i].second; 
-                        const double CA2 = table[i + 1].second;
-                        return CA1 + (CA2 - CA1) * ((ba - ba1) / (ba2 - ba1));
-                    }
+            void set_state(const Integration::State& state, const double time) {
+                dynamics.time = time;
+                dynamics.position.keys.x = state(0);
+                dynamics.position.keys.y = state(1);
+                dynamics.position.keys.z = state(2);
+                dynamics.attitude.keys.x = Geometry::normalise_angle_PI(state(3));
+                dynamics.attitude.keys.y = Geometry::normalise_angle_PI(state(4));
+                dynamics.attitude.keys.z = Geometry::normalise_angle_PI(state(5));
+                dynamics.V = state.tail(6);
+                if(halt_surge_and_sway) {
+                    dynamics.V(0) = 0.0;
+                    dynamics.V(1) = 0.0;
                 }
-                return -1; // Should not reach here
+                set_orientation();
             }
 
 
             /**
-             * @brief Estimates the drag coefficient for flow parallel to a submerged body's major axis.
+             * @brief Moves the ASV to a state and a time, and returns the rate of change of the state there.
              * 
-             * The coefficient is determined by interpolating values from DNVGL-RP-N103 (Table B-1, page 215),
-             * assuming the body has an elliptical cross-section. The function uses the ratio of the
-             * dimension perpendicular to the flow (`d`) and the dimension along the flow (`l`).
+             * The rate of the position is the velocity rotated to the world frame plus the ocean current, 
+             * the rate of the attitude is the angular velocity, as in set_pose(), and the rate of the 
+             * velocity is the acceleration from set_dynamics().
              * 
-             * @param l Length of the body along the direction of flow (in meters).
-             * @param d Characteristic dimension perpendicular to the flow (in meters).
-             * 
-             * @return double Drag coefficient for parallel flow (dimensionless).
-             * 
-             * @note If the d/l ratio falls outside the tabulated range, the closest boundary value is returned.
+             * @param state State vector (see Integration::State).
+             * @param time Time in seconds since the start of the simulation.
+             * @return Integration::State Time derivative of the state vector.
              */
-            double get_drag_coefficient_parallel_flow(const double l, const double d) const {
-                // Ref: DNVGL-RP-N103 Table B-1 (page 215)
-                // Waterplane is assumed to be elliptical.
-                // Define the table of d/l and C_ds values
-                std::vector<std::pair<double, double>> table = {
-                    {0.125, 0.22},
-                    {0.25, 0.3},
-                    {0.5, 0.6},
-                    {1.0, 1.0},
-                    {2.0, 1.6},
-                };
-                // Check if ba is within bounds
-                const double dl = d / l;
-                if (dl >= table.front().first) return table.front().second;
-                if (dl <= table.back().first) return table.back().second;
-                // Find the correct interval and interpolate
-                for (size_t i = 0; i < table.size() - 1; ++i) {
-                    if (dl <= table[i].first && dl >= table[i + 1].first) {
-                        const double dl1 = table[i].first; 
-                        const double dl2 = table[i + 1].first;
-                        const double Cds1 = table[i].second; 
-                        const double Cds2 = table[i + 1].second;
-                        return Cds1 + (Cds2 - Cds1) * ((dl - dl1) / (dl2 - dl1));
-                    }
+            Integration::State get_state_derivative(const Integration::State& state, const double time) {
+                set_state(state, time);
+                set_dynamics(time);
+                Integration::State derivative;
+                derivative.head(3) = get_rotation_matrix() * dynamics.V.head(3) + Eigen::Vector3d(ocean_current.first, ocean_current.second, 0.0);
+                derivative.segment(3, 3) = dynamics.V.tail(3);
+                derivative.tail(6) = dynamics.A;
+                if(halt_surge_and_sway) {
+                    derivative(6) = 0.0;
+                    derivative(7) = 0.0;
                 }
-                return -1; // Should not reach here
+                return derivative;
             }
 
-            
+
             /**
-             * @brief Estimates the drag coefficient for flow perpendicular to a submerged body's major axis.
-             * 
-             * The coefficient is determined using values from DNVGL-RP-N103 (Table B-2, page 217),
-             * assuming a rectangular cross-section. It is based on the ratio of the longer edge (`b`)
-             * to the shorter edge (`h`) of the body’s cross-section.
-             * 
-             * @param b Length of the longer edge perpendicular to flow (in meters).
-             * @param h Length of the shorter edge perpendicular to flow (in meters).
-             * 
-             * @return double Drag coefficient for perpendicular flow (dimensionless).
+             * @brief Computes and sets the wave encounter frequency for a moving ASV.
              * 
-             * @note If the b/h ratio falls outside the table range, the nearest boundary value is returned.
+             * Calculates the frequency at which the ASV encounters each wave component,
+             * accounting for vehicle speed and relative wave heading. The result is shared by
+             * set_mass() and set_wave_force() within a time step.
              */
-            double get_drag_coefficient_prependicular_flow(const double b, const double h) const { // b --> longer edge, h --> short edge.
-                // Ref: DNVGL-RP-N103 Table B-2 (page 217)
-                // Waterplane is assumed to be rectangular.
-                // Define the table of b/h and C_ds values
-                std::vector<std::pair<double, double>> table = {
-                    {1.0, 1.16},
-                    {5.0, 1.2},
-                    {10.0, 1.5},
-                    {std::numeric_limits<double>::infinity(), 1.9},
-                };
-                // Check if ba is within bounds
-                const double bh = b / h;
-                if (bh >= table.front().first) return table.front().second;
-                if (bh <= table.back().first) return table.back().second;
-                // Find the correct interval and interpolate
-                for (size_t i = 0; i < table.size() - 1; ++i) {
-                    if (bh <= table[i].first && bh >= table[i + 1].first) {
-                        const double bh1 = table[i].first; 
-                        const double bh2 = table[i + 1].first;
-                        const double Cds1 = table[i].second; 
-                        const double Cds2 = table[i + 1].second;
-                        return Cds1 + (Cds2 - Cds1) * ((bh - bh1) / (bh2 - bh1));
-                    }
-                }
-                return -1; // Should not reach here
+            void set_encounter_frequency() {
+                const RegularWave<N, Trig, Real>& waves = sea_surface->component_waves;
+                const double asv_speed = dynamics.V(0,0);
+                dispatch_component_count<N>(waves.frequency.size(), [&]<int M>() {
+                    const size_t size = waves.frequency.size();
+                    const ComponentArray<M> frequency (waves.frequency.data(), size);
+                    const ComponentArray<M> heading   (waves.heading.data(),   size);
+                    const Eigen::Array<double, M, 1> relative_wave_heading = Trig::normalise_angle_PI(heading - dynamics.attitude.keys.z);
+                    encounter_freq = frequency - (frequency.square()/ASVLite::Constants::G) * asv_speed 
+                                     * Trig::cos(relative_wave_heading.template cast<Real>()).template cast<double>();
+                });
             }
 
-            
+
             /**
              * @brief Computes and sets the mass and added mass matrix for the ASV.
              * 
@@ -608,7 +985,8 @@ namespace ASVLite {
              * - **Moments of inertia** (roll, pitch, yaw) using standard formulas for ellipsoidal bodies.
              * - **Added mass** (heave, roll, pitch) from wave encounter frequency and empirical coefficients.
              * 
-             * @throws std::runtime_error If the computed added mass coefficient is invalid.
+             * @note The rigid body terms and empirical coefficients are taken from the hull coefficients
+             *       cached at construction (see AsvHullCoefficients).
              * 
              * @note Added mass is only applied to oscillatory DOFs (heave, roll, pitch); surge, sway,
              *       and yaw added masses are currently set to zero.
@@ -616,38 +994,14 @@ namespace ASVLite {
              * @ref DNVGL-RP-N103 for added mass coefficient reference.
              */
             void set_mass() {
-                // Mass of the ASV
-                const double submerged_volume = get_submerged_volume(-spec.T);
-                const double asv_mass = submerged_volume * Constants::SEA_WATER_DENSITY;
-                // Moment of inertia for angular motions considering an elliptical waterplane.
-                const double I_roll =  (1.0 / 20.0) * asv_mass * (spec.B_wl*spec.B_wl + spec.T*spec.T); // Roll
-                const double I_pitch = (1.0 / 20.0) * asv_mass * (spec.L_wl*spec.L_wl + spec.T*spec.T);  // Pitch
-                const double I_yaw =   (1.0 / 20.0) * asv_mass * (spec.L_wl*spec.L_wl + spec.B_wl*spec.B_wl);  // Yaw
-                // Added mass of the ASV - only associated with oscillatory motions.
-                const double added_mass_surge = 0.0;
-                const double added_mass_sway  = 0.0;
-                const double added_mass_yaw = 0.0;
-                // Added mass coeffient
-                const double C_linear = get_added_mass_coeff();
-                if(C_linear < 0.0) {
-                    throw std::runtime_error("Invalid added mass coefficient");
-                }
-                const double V_r = M_PI/6.0 * spec.B_wl*spec.B_wl * spec.L_wl;
-                const double C_angular = 0.2;
-                // Encounter frequency 
-                const Eigen::Vector<double, N> relative_wave_heading = (sea_surface->component_waves.heading.array() - dynamics.attitude.keys.z).unaryExpr(&Geometry::normalise_angle_PI);
-                const Eigen::Vector<double, N> encounter_freq = get_encounter_frequency(dynamics.V(0,0), sea_surface->component_waves.frequency, relative_wave_heading);
-                // Added mass for heave, pitch and roll
-                double added_mass_heave = (encounter_freq.array().square() / N * C_linear * Constants::SEA_WATER_DENSITY * V_r).sum();
-                double added_mass_roll  = (encounter_freq.array().square() / N * C_angular * Constants::SEA_WATER_DENSITY * submerged_volume * (spec.B_wl*spec.B_wl + spec.T*spec.T)/5.0).sum();
-                double added_mass_pitch = (encounter_freq.array().square() / N * C_angular * Constants::SEA_WATER_DENSITY * submerged_volume * (spec.L_wl*spec.L_wl + spec.T*spec.T)/5.0).sum();
-                // Set the mass matrixs
-                dynamics.M(0, 0) = asv_mass + added_mass_surge;
-                dynamics.M(1, 1) = asv_mass + added_mass_sway;
-                dynamics.M(2, 2) = asv_mass + added_mass_heave;
-                dynamics.M(3, 3) = I_roll   + added_mass_roll;
-                dynamics.M(4, 4) = I_pitch  + added_mass_pitch;
-                dynamics.M(5, 5) = I_yaw    + added_mass_yaw;
+                // Added mass for heave, pitch and roll. Added mass is only associated with oscillatory motions,
+                // so surge, sway and yaw keep the rigid body terms set at construction.
+                // Averaged over the frequency bands of the spectrum, as the wave force (see set_wave_force()), so pruned 
+                // components count as encountered at zero frequency and pruning does not change the normalisation.
+                const double mean_encounter_freq_square = encounter_freq.square().sum() / sea_surface->count_component_waves;
+                dynamics.M.set(2, 2, hull.mass    + hull.added_mass_heave_factor * mean_encounter_freq_square);
+                dynamics.M.set(3, 3, hull.I_roll  + hull.added_mass_roll_factor  * mean_encounter_freq_square);
+                dynamics.M.set(4, 4, hull.I_pitch + hull.added_mass_pitch_factor * mean_encounter_freq_square);
             }
 
 
@@ -666,34 +1020,18 @@ namespace ASVLite {
              * 
              * @note The drag coefficient matrix `C` is diagonal and populated with corresponding
              *       force coefficients for each DOF. Submersion depth is clamped between 0 and -D.
+             *       Only the depth dependent surge and sway terms are updated here, the remaining 
+             *       coefficients are cached in AsvHullCoefficients.
              * 
              * @ref DNVGL-RP-N103, Appendix B, Tables B-1 and B-2.  
              * @ref Handbook of Marine Craft Hydrodynamics and Motion Control, p. 125.
              */
             void set_drag_coefficient() {
-                // Ref: Recommended practices DNVGL-RP-N103 Modelling and analysis of marine
-                // operations. Edition July 2017. Appendix B Table B-1, B-2.
-                // Surge drag coefficient - assuming elliptical waterplane area
+                // Surge and sway drag scale with the submersion depth. Heave, roll, pitch and yaw drag 
+                // coefficients depend only on the hull and are set at construction.
                 const double c = -std::clamp(dynamics.submersion_depth, -spec.D, 0.0);
-                const double C_DS_surge = get_drag_coefficient_parallel_flow(spec.L_wl, spec.B_wl);
-                const double C_DS_sway  = get_drag_coefficient_parallel_flow(spec.B_wl, spec.L_wl);
-                const double C_surge = 0.5 * Constants::SEA_WATER_DENSITY * C_DS_surge * spec.B_wl * c;
-                const double C_sway  = 0.5 * Constants::SEA_WATER_DENSITY * C_DS_sway  * spec.L_wl * c;
-                // Heave drag coefficient - consider it as flat plat perpendicular to flow.
-                const double C_DS_heave = get_drag_coefficient_prependicular_flow(spec.L_wl, spec.B_wl);
-                const double C_heave  = 0.5 * Constants::SEA_WATER_DENSITY * C_DS_heave  * spec.L_wl * spec.B_wl;
-                // roll, pitch and yaw drag coefficient set equal to roll damping coefficient 
-                // given in Handbook of Marin Craft Hydrodynamics and motion control, page 125
-                const double C_roll  = 1.5 * Constants::SEA_WATER_DENSITY * spec.B_wl*spec.B_wl*spec.B_wl * spec.T;
-                const double C_pitch = 1.5 * Constants::SEA_WATER_DENSITY * spec.L_wl*spec.L_wl*spec.L_wl * spec.T;
-                const double C_yaw   = 1.5 * Constants::SEA_WATER_DENSITY * spec.B_wl*spec.B_wl*spec.B_wl * spec.L_wl;
-                // Set the drage coeff matrix
-                dynamics.C(0, 0) = C_surge;
-                dynamics.C(1, 1) = C_sway;
-                dynamics.C(2, 2) = C_heave;
-                dynamics.C(3, 3) = C_roll;
-                dynamics.C(4, 4) = C_pitch;
-                dynamics.C(5, 5) = C_yaw;
+                dynamics.C.set(0, 0, hull.C_surge_factor * c);
+                dynamics.C.set(1, 1, hull.C_sway_factor  * c);
             }
 
 
@@ -738,12 +1076,12 @@ namespace ASVLite {
                 // Ref: Dynamics of Marine Vehicles, R. Bhattacharyya, page 66
                 const double K_pitch = I_yy * Constants::SEA_WATER_DENSITY * Constants::G;
                 // Set the stiffeness matrix
-                dynamics.K(0, 0) = K_surge;
-                dynamics.K(1, 1) = K_sway;
-                dynamics.K(2, 2) = K_heave;
-                dynamics.K(3, 3) = K_roll;
-                dynamics.K(4, 4) = K_pitch;
-                dynamics.K(5, 5) = K_yaw;
+                dynamics.K.set(0, 0, K_surge);
+                dynamics.K.set(1, 1, K_sway);
+                dynamics.K.set(2, 2, K_heave);
+                dynamics.K.set(3, 3, K_roll);
+                dynamics.K.set(4, 4, K_pitch);
+                dynamics.K.set(5, 5, K_yaw);
             }
 
 
@@ -757,80 +1095,81 @@ namespace ASVLite {
              * 
              * Key steps in the computation:
              * - Computes the waterplane geometry assuming an elliptical shape based on submersion depth.
-             * - Computes world-frame positions of key points using intrinsic Z-Y-X (yaw–pitch–roll) rotation.
+             * - Computes world-frame offsets of key points using intrinsic Z-Y-X (yaw–pitch–roll) rotation.
              * - Calculates wave pressures at these points using the encountered wave spectrum (adjusted for encounter frequency).
              * - Computes vertical and rotational force components (heave, roll, pitch) from distributed pressure fields.
              * 
+             * The pressures at all five points are evaluated in one pass over the N component waves. The
+             * temporal term and the phase at the centre are computed once per component, and the phase at
+             * each of the other points is the centre phase plus the projection of its offset on the wave
+             * number vector.
+             * 
              * @note 
-             * - Force contributions in surge, sway, and yaw directions are currently commented out.
+             * - Force contributions in surge, sway, and yaw directions are not modelled.
              * - Submersion depth is clamped to ensure valid waterplane dimensions.
              * - Only applied if the ASV is submerged (negative submersion depth).
              * 
              * @ref DNVGL-RP-N103 and linear wave theory for wave pressure calculations.
              */
             void set_wave_force() {
+                // Reset the wave force to all zeros
+                dynamics.F_wave = Eigen::Matrix<double, 6, 1>::Zero();
+                if(dynamics.submersion_depth >= 0.0) {
+                    return;
+                }
                 // Assuming elliptical shape for the water plane area.
                 // Get the dimensions of the ellipse for the waterplane at the given submersion depth.
                 const double c = -std::clamp(dynamics.submersion_depth, -spec.D, 0.0);
                 const double a = spec.L_wl/2.0 * sqrt(1 - (spec.D - c)/spec.D);
                 const double b = spec.B_wl/2.0 * sqrt(1 - (spec.D - c)/spec.D);
-                const double A_trans = M_PI/2.0 * b * c;
-                const double A_profile = M_PI/2.0 * a * c;
                 const double A_waterplane = M_PI/2 * a * b;
-                // Reset the wave force to all zeros
-                dynamics.F_wave = Eigen::Matrix<double, 6, 1>::Zero();
-                if(dynamics.submersion_depth >= 0.0) {
-                    dynamics.F_wave = Eigen::Matrix<double, 6, 1>::Zero();
-                } else {
-                    // Compute the coordinates of fore, aft, port side, starboard side and centre position of the vehicle for calculating wave pressure.
-                    // Step 1: Create rotation matrix (intrinsic Z-Y-X: yaw -> pitch -> roll)
-                    const Eigen::Matrix3d R (Eigen::AngleAxisd(dynamics.attitude.keys.z, Eigen::Vector3d::UnitZ())*  // yaw  
-                                             Eigen::AngleAxisd(dynamics.attitude.keys.y, Eigen::Vector3d::UnitY())*  // pitch 
-                                             Eigen::AngleAxisd(dynamics.attitude.keys.x, Eigen::Vector3d::UnitX())); // roll 
-                    // Step 2: Define the direction vectors in the body frame
-                    const Eigen::Vector3d forward_direction_local_frame(1.0, 0.0, 0.0);
-                    const Eigen::Vector3d aft_direction_local_frame(-1.0, 0.0, 0.0);
-                    const Eigen::Vector3d starboard_direction_local_frame(0.0, 1.0, 0.0);
-                    const Eigen::Vector3d portside_direction_local_frame(1.0, -1.0, 0.0);
-                    // Step 3: Rotate direction vectors into world frame
-                    const Eigen::Vector3d forward_direction_world_frame   = R * forward_direction_local_frame;
-                    const Eigen::Vector3d aft_direction_world_frame       = R * aft_direction_local_frame;
-                    const Eigen::Vector3d starboard_direction_world_frame = R * starboard_direction_local_frame;
-                    const Eigen::Vector3d portside_direction_world_frame  = R * portside_direction_local_frame;
-                    // Step 4: Compute coordinates of the positions in world frame
-                    const Eigen::Vector3d position_centre(dynamics.position.keys.x, dynamics.position.keys.y, dynamics.position.keys.z);
-                    const Eigen::Vector3d position_forward   = position_centre + (a/2 * forward_direction_world_frame);
-                    const Eigen::Vector3d position_aft       = position_centre + (a/2 * aft_direction_world_frame);
-                    const Eigen::Vector3d position_starboard = position_centre + (b/2 * starboard_direction_world_frame);
-                    const Eigen::Vector3d position_portside  = position_centre + (b/2 * portside_direction_world_frame);
-                    // Construct Coordinate3D objects for these positions
-                    const Geometry::Coordinates3D pos_centre{position_centre(0), position_centre(1), position_centre(2)};
-                    const Geometry::Coordinates3D pos_forward{position_forward(0), position_forward(1), position_forward(2)};
-                    const Geometry::Coordinates3D pos_aft{position_aft(0), position_aft(1), position_aft(2)};
-                    const Geometry::Coordinates3D pos_starboard{position_starboard(0), position_starboard(1), position_starboard(2)};
-                    const Geometry::Coordinates3D pos_porside{position_portside(0), position_portside(1), position_portside(2)};
-                    // For each wave in the wave spectrum, compute the wave pressure force
-                    const Eigen::Vector<double, N> relative_wave_heading = (sea_surface->component_waves.heading.array() - dynamics.attitude.keys.z).unaryExpr(&Geometry::normalise_angle_PI);
-                    const Eigen::Vector<double, N> encounter_freq = get_encounter_frequency(dynamics.V(0,0), sea_surface->component_waves.frequency, relative_wave_heading);
-                    const RegularWave<N> encountered_waves {sea_surface->component_waves.amplitude, encounter_freq, sea_surface->component_waves.phase_lag, sea_surface->component_waves.heading};
-                    const Eigen::Vector<double, N> wave_pressure_centre     = encountered_waves.get_wave_pressure(pos_centre    , dynamics.time); 
-                    const Eigen::Vector<double, N> wave_pressure_forward    = encountered_waves.get_wave_pressure(pos_forward   , dynamics.time); 
-                    const Eigen::Vector<double, N> wave_pressure_aft        = encountered_waves.get_wave_pressure(pos_aft       , dynamics.time); 
-                    const Eigen::Vector<double, N> wave_pressure_starboard  = encountered_waves.get_wave_pressure(pos_starboard , dynamics.time); 
-                    const Eigen::Vector<double, N> wave_pressure_portside   = encountered_waves.get_wave_pressure(pos_porside   , dynamics.time); 
-                    // Lever
-                    const double lever_trans = b / 8;
-                    const double lever_long  = a / 8;
-                    // Set the wave pressue force matrix
-                    const double scale = 1.0/N;
-                    // dynamics.F_wave(0) += ((wave_pressure_forward - wave_pressure_aft) * A_trans * scale).sum(); // surge
-                    // dynamics.F_wave(1) += ((wave_pressure_starboard - wave_pressure_portside) * A_profile * scale).sum(); // sway
-                    dynamics.F_wave(2) += (wave_pressure_centre * A_waterplane * scale).sum(); // heave
-                    dynamics.F_wave(3) += ((wave_pressure_starboard - wave_pressure_portside) * A_waterplane * lever_trans * scale).sum(); // roll
-                    dynamics.F_wave(4) += ((wave_pressure_forward - wave_pressure_aft) * A_waterplane * lever_long * scale).sum(); // pitch
-                    // dynamics.F_wave(5) += ((wave_pressure_forward - wave_pressure_aft) * A_profile * lever_long * scale).sum(); // yaw
-                } 
-            
+                // Offsets of the fore, starboard and portside positions from the centre of the vehicle in the world frame.
+                const Eigen::Matrix3d& R = get_rotation_matrix();
+                const Eigen::Vector3d offset_forward   = a/2 * (R * Eigen::Vector3d(1.0, 0.0, 0.0));
+                const Eigen::Vector3d offset_starboard = b/2 * (R * Eigen::Vector3d(0.0, 1.0, 0.0));
+                const Eigen::Vector3d offset_portside  = b/2 * (R * Eigen::Vector3d(1.0, -1.0, 0.0));
+                // The aft position is offset by -offset_forward.
+                // Encountered waves.
+                // Wave number from linear wave theory for the encounter frequency: k = (2 PI f)^2 / g.
+                // The encountered waves propagate in the direction (PI/2 - heading), the heading passed through 
+                // RegularWave's frame switch a second time, so their direction cosines are the sine and cosine of the heading.
+                const RegularWave<N, Trig, Real>& waves = sea_surface->component_waves;
+                const auto [pressure_centre, pressure_trans, pressure_long] = dispatch_component_count<N>(waves.amplitude.size(), [&]<int M>() {
+                    const size_t size = waves.amplitude.size();
+                    const ComponentArray<M> amplitude   (waves.amplitude.data(),   size);
+                    const ComponentArray<M> phase_lag   (waves.phase_lag.data(),   size);
+                    const ComponentArray<M> heading_cos (waves.heading_cos.data(), size);
+                    const ComponentArray<M> heading_sin (waves.heading_sin.data(), size);
+                    const Eigen::Array<double, M, 1> wave_number = (2.0 * M_PI * encounter_freq).square() / Constants::G;
+                    const Eigen::Array<double, M, 1> k_x = wave_number * heading_sin;
+                    const Eigen::Array<double, M, 1> k_y = wave_number * heading_cos;
+                    // Phase at the centre, and the phase shift to each of the other positions. The phase at the centre
+                    // grows with time and distance, so it is computed in double precision and reduced before the 
+                    // conversion to Real. The shifts are bounded by the hull dimensions.
+                    const Eigen::Array<Real, M, 1> phase_centre = Trigonometry::reduce_phase<Real>(
+                                                                    k_x * dynamics.position.keys.x + k_y * dynamics.position.keys.y
+                                                                    - 2.0 * M_PI * encounter_freq * dynamics.time + phase_lag);
+                    const Eigen::Array<Real, M, 1> shift_forward   = (k_x * offset_forward(0)   + k_y * offset_forward(1)).template cast<Real>();
+                    const Eigen::Array<Real, M, 1> shift_starboard = (k_x * offset_starboard(0) + k_y * offset_starboard(1)).template cast<Real>();
+                    const Eigen::Array<Real, M, 1> shift_portside  = (k_x * offset_portside(0)  + k_y * offset_portside(1)).template cast<Real>();
+                    // Wave pressure at each position
+                    const Eigen::Array<Real, M, 1> pressure_amplitude = (-Constants::SEA_WATER_DENSITY * Constants::G * amplitude).template cast<Real>();
+                    return std::array<double, 3> {
+                        (pressure_amplitude * Trig::cos(phase_centre)).sum(),
+                        (pressure_amplitude * (Trig::cos(phase_centre + shift_starboard) - Trig::cos(phase_centre + shift_portside))).sum(),
+                        (pressure_amplitude * (Trig::cos(phase_centre + shift_forward)   - Trig::cos(phase_centre - shift_forward))).sum()
+                    };
+                });
+                // Lever
+                const double lever_trans = b / 8;
+                const double lever_long  = a / 8;
+                // Set the wave pressue force matrix
+                // Averaged over the frequency bands of the spectrum, so pruned components count as contributing no pressure.
+                // The mean encounter frequency of the added mass is normalised the same way (see set_mass()).
+                const double scale = 1.0/sea_surface->count_component_waves;
+                dynamics.F_wave(2) = pressure_centre * A_waterplane * scale; // heave
+                dynamics.F_wave(3) = pressure_trans * A_waterplane * lever_trans * scale; // roll
+                dynamics.F_wave(4) = pressure_long * A_waterplane * lever_long * scale; // pitch
             }
 
 
@@ -877,7 +1216,7 @@ namespace ASVLite {
              * using a quadratic formulation.  
              * 
              * Special handling is applied for the **heave** direction:
-             * - Heave drag is computed relative to the vertical velocity of the sea surface.
+             * - Heave drag is computed relative to the vertical velocity of the sea surface, set by step_simulation().
              * - If the ASV is above water (non-submerged), drag is set to zero.
              * 
              * @note This function internally calls `set_drag_coefficient()` to ensure up-to-date coefficients.
@@ -887,19 +1226,15 @@ namespace ASVLite {
             void set_drag_force() {
                 set_drag_coefficient();
             
-                // Compute the quadratic velocity term explicitly to avoid unnecessary temporaries
-                Eigen::VectorXd velocity_square = dynamics.V.cwiseProduct(dynamics.V.cwiseAbs());
-                // Set the drag force matrix
-                dynamics.F_drag = -dynamics.C * velocity_square;
-                // For heave the drag should be relative to the water surface velocity
                 if(dynamics.submersion_depth >= 0.0) {
                     dynamics.F_drag = Eigen::Matrix<double, 6, 1>::Zero();
-                } else {
-                    const double sea_surface_elevation_0 = sea_surface->get_elevation(dynamics.position, dynamics.time - dynamics.time_step_size/1000.0);
-                    const double sea_surface_elevation_1 = sea_surface->get_elevation(dynamics.position, dynamics.time);
-                    const double sea_surface_velocity =  (sea_surface_elevation_1 - sea_surface_elevation_0) / (dynamics.time_step_size/1000.0);
-                    dynamics.F_drag(2) = -dynamics.C(2,2) * (dynamics.V(2) - sea_surface_velocity) * std::abs(dynamics.V(2) - sea_surface_velocity);
+                    return;
                 }
+                // Velocity relative to the water. For heave the drag should be relative to the water surface velocity.
+                Eigen::Matrix<double, 6, 1> relative_velocity = dynamics.V;
+                relative_velocity(2) -= dynamics.sea_surface_velocity;
+                // Set the drag force matrix
+                dynamics.F_drag = -dynamics.C.multiply(relative_velocity.cwiseProduct(relative_velocity.cwiseAbs()));
             }
 
 
@@ -911,7 +1246,7 @@ namespace ASVLite {
              * the stiffness matrix and the displacement from equilibrium.
              * 
              * Key details:
-             * - A 3×3 submatrix of the stiffness matrix is used to compute restoring forces for heave, roll, and pitch.
+             * - The heave, roll and pitch rows of the stiffness matrix are used to compute restoring forces for heave, roll, and pitch.
              * - Restoring forces in surge, sway, and yaw are assumed to be zero.
              * 
              * @note This function internally calls `set_stiffness()` to ensure the stiffness matrix is up to date.
@@ -923,14 +1258,13 @@ namespace ASVLite {
              
                 // Heave restoring force
                 const double delta_T = spec.T + dynamics.submersion_depth;
-                const Eigen::Vector3d elongation {delta_T, dynamics.attitude.keys.x, dynamics.attitude.keys.y};
+                Eigen::Matrix<double, 6, 1> elongation = Eigen::Matrix<double, 6, 1>::Zero();
+                elongation.segment(2,3) << delta_T, dynamics.attitude.keys.x, dynamics.attitude.keys.y;
                 // Set the restoring force matrix
-                const Eigen::Matrix3d K_sub = dynamics.K.block<3,3>(2,2); // Extract the relevant 3x3 submatrix from K
-                dynamics.F_restoring.segment(2,3) = -K_sub * elongation; // heave, roll, pitch
+                dynamics.F_restoring.segment(2,3) = -dynamics.K.multiply(elongation).segment(2,3); // heave, roll, pitch
                 // Overwrite the heave restoring force with the buoyancy - weight 
-                double buoyancy = get_submerged_volume(dynamics.submersion_depth) * Constants::SEA_WATER_DENSITY * Constants::G;
-                double weight = get_submerged_volume(-spec.T) * Constants::SEA_WATER_DENSITY * Constants::G;
-                dynamics.F_restoring(2) = buoyancy - weight;
+                double buoyancy = Hydrodynamics::get_submerged_volume(spec, dynamics.submersion_depth) * Constants::SEA_WATER_DENSITY * Constants::G;
+                dynamics.F_restoring(2) = buoyancy - hull.weight;
                 // No restoring force for sway, yaw and surge.
             }
 
@@ -952,19 +1286,23 @@ namespace ASVLite {
 
             /**
              * @brief Computes and sets the acceleration of the ASV.
+             * 
+             * Solves M A = F with the structure of the mass matrix, without forming its inverse.
              */
             void set_acceleration() {
                 // Set acceleration matrix
-                dynamics.A = dynamics.M.inverse() * dynamics.F;
+                dynamics.A = dynamics.M.solve(dynamics.F);
             }
 
             
             /**
              * @brief Computes and sets the velocity of the ASV.
+             * 
+             * @param step_size Time step in seconds.
              */
-            void set_velocity() {
+            void set_velocity(const double step_size) {
                 // Set velocity matrix
-                dynamics.V = dynamics.V + (dynamics.A * dynamics.time_step_size/1000.0);
+                dynamics.V = dynamics.V + (dynamics.A * step_size);
                 if(halt_surge_and_sway) {
                     dynamics.V(0) = 0.0;
                     dynamics.V(1) = 0.0;
@@ -986,13 +1324,12 @@ namespace ASVLite {
              * - Integrate the velocity over the time step to compute the displacement.
              * 
              * @note The ocean current is only considered in the linear velocity components (X and Y).
+             * 
+             * @param step_size Time step in seconds.
              */
-            void set_deflection() {
+            void set_deflection(const double step_size) {
                 // Construct a resultant velocity matrix in body frame considering ocean current
-                // Create rotation matrix (intrinsic Z-Y-X: yaw -> pitch -> roll)
-                const Eigen::Matrix3d R (Eigen::AngleAxisd(dynamics.attitude.keys.z, Eigen::Vector3d::UnitZ())*  // yaw  
-                                         Eigen::AngleAxisd(dynamics.attitude.keys.y, Eigen::Vector3d::UnitY())*  // pitch 
-                                         Eigen::AngleAxisd(dynamics.attitude.keys.x, Eigen::Vector3d::UnitX())); // roll 
+                const Eigen::Matrix3d& R = get_rotation_matrix();
                 // Global velocity in world frame (only X and Y are given)
                 const Eigen::Vector3d V_current_global(ocean_current.first, ocean_current.second, 0.0);
                 // Convert global velocity to body frame (R^T * V_current_global)
@@ -1001,7 +1338,7 @@ namespace ASVLite {
                 Eigen::Matrix<double, 6, 1> V_net = dynamics.V;
                 V_net.head(3) += V_current_body;  // Add only the linear velocity components
                 // Set deflection matrix
-                dynamics.X = V_net * dynamics.time_step_size/1000.0;
+                dynamics.X = V_net * step_size;
             }
 
 
@@ -1016,8 +1353,9 @@ namespace ASVLite {
              * Steps:
              * - The attitude angles (roll, pitch, yaw) are updated and normalised to ensure they remain 
              *   within the valid range of [-PI, PI].
-             * - A rotation matrix is created using the updated attitude to rotate the deflection vector 
-             *   from the body frame to the global frame.
+             * - The attitude quaternion is updated, and its rotation matrix rotates the deflection vector 
+             *   from the body frame to the global frame. The same matrix serves the wave force and the 
+             *   deflection of the next time step.
              * - The new position is computed by adding the rotated deflection vector to the current position.
              * 
              * @note The attitude is updated using the intrinsic Z-Y-X rotation sequence (yaw-pitch-roll).
@@ -1027,11 +1365,8 @@ namespace ASVLite {
                 dynamics.attitude.keys.x = Geometry::normalise_angle_PI(dynamics.attitude.keys.x + dynamics.X(3));
                 dynamics.attitude.keys.y = Geometry::normalise_angle_PI(dynamics.attitude.keys.y + dynamics.X(4));
                 dynamics.attitude.keys.z = Geometry::normalise_angle_PI(dynamics.attitude.keys.z + dynamics.X(5)); 
-            
-                // Create rotation matrix (intrinsic Z-Y-X: yaw -> pitch -> roll)
-                const Eigen::Matrix3d R (Eigen::AngleAxisd(dynamics.attitude.keys.z, Eigen::Vector3d::UnitZ())*  // yaw  
-                                         Eigen::AngleAxisd(dynamics.attitude.keys.y, Eigen::Vector3d::UnitY())*  // pitch 
-                                         Eigen::AngleAxisd(dynamics.attitude.keys.x, Eigen::Vector3d::UnitX())); // roll 
+                set_orientation();
+                const Eigen::Matrix3d& R = get_rotation_matrix();
                 // Rotate Deflection Vector from Body Frame to Global Frame
                 const Eigen::Vector3d X_global = R * dynamics.X.topRows(3);
                 // Compute New Position in Global Frame
@@ -1045,21 +1380,71 @@ namespace ASVLite {
         
         private:
 
+            /**
+             * @brief Composes the attitude quaternion from the Euler angles, after a change of the attitude.
+             */
+            void set_orientation() {
+                // Intrinsic Z-Y-X: yaw -> pitch -> roll
+                dynamics.orientation = Eigen::AngleAxisd(dynamics.attitude.keys.z, Eigen::Vector3d::UnitZ()) *  // yaw
+                                       Eigen::AngleAxisd(dynamics.attitude.keys.y, Eigen::Vector3d::UnitY()) *  // pitch
+                                       Eigen::AngleAxisd(dynamics.attitude.keys.x, Eigen::Vector3d::UnitX());   // roll
+                is_rotation_matrix_current = false;
+            }
+
+
+            /**
+             * @brief Returns the rotation matrix of the attitude quaternion, computing it on the first call after a change of the attitude.
+             */
+            const Eigen::Matrix3d& get_rotation_matrix() {
+                if(!is_rotation_matrix_current) {
+                    rotation_matrix = dynamics.orientation.toRotationMatrix();
+                    is_rotation_matrix_current = true;
+                }
+                return rotation_matrix;
+            }
+
+
             // ASV specification
             /** @brief Geometric specifications of the ASV (e.g., length, breadth, draught). */
             const AsvSpecification spec;
 
+            /** @brief Hull coefficients derived from the specification, computed once at construction. */
+            const AsvHullCoefficients hull;
+
             /** @brief Pointer to the irregular sea surface model affecting the ASV. */
-            const SeaSurface<N>* sea_surface;
+            const SeaSurface<N, Trig, Real>* sea_surface;
 
             /** @brief Zonal and meridional velocities of the ocean current (in m/s). */
             std::pair<double, double> ocean_current{0.0, 0.0};
 
+            /** @brief Time integration scheme. */
+            Integrator integrator;
+
+            /** @brief Point of thrust application in the body-fixed frame, for the current time step. */
+            Geometry::Coordinates3D thrust_position;
+
+            /** @brief Thrust in the body-fixed frame, for the current time step. */
+            Geometry::Coordinates3D thrust_magnitude;
+
             /** @brief Flag to halt surge and sway motions of the ASV. Set to true to keep the ASV stationary. */
             bool halt_surge_and_sway {false};
 
             /** @brief Dynamics and state variables of the ASV, including position, velocity, and forces. */
-            AsvDynamics dynamics;    
+            AsvDynamics<Structure> dynamics;    
+
+            /** @brief Frequency (in Hz) at which the ASV encounters each component wave in the current time step. 
+             *         Sized to the padded component count whenever the sea surface is set, so that the steps 
+             *         do not allocate for N = DYNAMIC. */
+            Eigen::Array<double, EIGEN_SIZE<N>, 1> encounter_freq;
+
+            /** @brief Rate of the wave force and added mass updates, and the last updates. */
+            WaveForceSchedule<Eigen::Matrix<double, 6, 1>, Eigen::Vector3d> wave_force_schedule;
+
+            /** @brief Rotation matrix of dynamics.orientation, valid while is_rotation_matrix_current is true. */
+            Eigen::Matrix3d rotation_matrix;
+
+            /** @brief True if rotation_matrix is up to date with the attitude. */
+            bool is_rotation_matrix_current {false};
 
     };
 
@@ -1077,7 +1462,8 @@ namespace ASVLite {
      * The thrust position is assumed to be located at the center of the wave glider's body, and thrust magnitude is 
      * scaled by factors depending on the wave height and vehicle parameters.
      * 
-     * @param wave_glider Reference to the ASV (wave glider) for which thrust is being calculated.
+     * @param wave_glider_spec Geometric specification of the wave glider.
+     * @param wave_glider_velocity Current velocity of the wave glider (surge and heave are used).
      * @param rudder_angle Angle of the rudder relative to the X-axis of the ASV, in radians. The angle is positive 
      *        when the vehicle turns to starboard (aft of the rudder points to starboard side).
      * @param significant_wave_ht Significant wave height (in meters), used to tune the thrust calculation.
@@ -1091,10 +1477,10 @@ namespace ASVLite {
      * 
      * @ref Dynamic modeling and simulations of the wave glider, Peng Wang, Xinliang Tian, Wenyue Lu, Zhihuan Hu, Yong Luo.
      */
-    template<size_t N>
-    std::pair<Geometry::Coordinates3D, Geometry::Coordinates3D> get_wave_glider_thrust(const Asv<N>& wave_glider, const double rudder_angle, const double significant_wave_ht) {
-        auto wave_glider_spec = wave_glider.get_spec(); 
-        
+    inline std::pair<Geometry::Coordinates3D, Geometry::Coordinates3D> get_wave_glider_thrust(const AsvSpecification& wave_glider_spec, 
+                                                                                            const Geometry::RigidBodyDOF& wave_glider_velocity, 
+                                                                                            const double rudder_angle, 
+                                                                                            const double significant_wave_ht) {
         std::pair<Geometry::Coordinates3D, Geometry::Coordinates3D> return_value;
         return_value.first = {-wave_glider_spec.L_wl/2, 0, 0}; // Thrust position
         return_value.second = {0, 0, 0}; // Thrust magnitude
@@ -1122,7 +1508,7 @@ namespace ASVLite {
         const double C_DO = 0.008;
         const double C_L_1 = (1.8 * M_PI * lambda * alpha_k) / (cos(chi) * sqrt(lambda*lambda/pow(cos(chi), 4) + 4) + 1.8) + (C_DC/ lambda * alpha_k*alpha_k);
         const double C_D = C_DO + C_L_1*C_L_1 / (0.9 * M_PI * lambda);
-        const double V_heave = wave_glider.get_velocity().keys.heave;
+        const double V_heave = wave_glider_velocity.keys.heave;
         const double F_L = 0.5 * Constants::SEA_WATER_DENSITY * C_L_1 * A * V_heave*V_heave;
         const double F_D = 0.5 * Constants::SEA_WATER_DENSITY * C_D * A * V_heave*V_heave;
         const double thrust_per_hydrofoil = F_L * sin(alpha_f_1) - F_D * cos(alpha_f_1);
@@ -1155,7 +1541,7 @@ namespace ASVLite {
         // Assuming the rudder area = area of a hydrofoil
         const double A_rudder = 0.4 * 0.2 ; // m2
         const double alpha_f_2 = rudder_angle; // radians
-        const double V_surge = wave_glider.get_velocity().keys.surge;
+        const double V_surge = wave_glider_velocity.keys.surge;
         const double C_L_2 = (1.8 * M_PI * lambda * alpha_k) / (cos(chi) * sqrt(lambda*lambda/pow(cos(chi), 4) + 4) + 1.8) + (C_DC/ lambda * alpha_k*alpha_k);
         const double F_L_rudder = 0.5 * Constants::SEA_WATER_DENSITY * C_L_2 * A_rudder * V_surge * V_surge;
         double rudder_thrust = F_L_rudder * sin(alpha_f_2);
@@ -1163,6 +1549,23 @@ namespace ASVLite {
         return_value.second.keys.y = rudder_thrust;
 
         return return_value;
-    } 
+    }
+
+
+    /**
+     * @brief Computes the position and magnitude of propulsive thrust generated by the subsurface gliders.
+     * 
+     * @param wave_glider Reference to the ASV (wave glider) for which thrust is being calculated.
+     * @param rudder_angle Angle of the rudder relative to the X-axis of the ASV, in radians.
+     * @param significant_wave_ht Significant wave height (in meters), used to tune the thrust calculation.
+     * 
+     * @return std::pair<Geometry::Coordinates3D, Geometry::Coordinates3D> Thrust position and thrust magnitude in the body frame.
+     * 
+     * @see get_wave_glider_thrust(const AsvSpecification&, const Geometry::RigidBodyDOF&, const double, const double)
+     */
+    template<size_t N, typename Trig, typename Real, typename Structure, typename Integrator>
+    std::pair<Geometry::Coordinates3D, Geometry::Coordinates3D> get_wave_glider_thrust(const Asv<N, Trig, Real, Structure, Integrator>& wave_glider, const double rudder_angle, const double significant_wave_ht) {
+        return get_wave_glider_thrust(wave_glider.get_spec(), wave_glider.get_velocity(), rudder_angle, significant_wave_ht);
+    }
 
 }
\ No newline at end of file
@@ -0,0 +1,845 @@
+#pragma once
+
+#include "geometry.h"
+#include "sea_surface.h"
+#include "asv.h"
+#include "wave_force_schedule.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+
+namespace ASVLite {
+
+    /**
+     * @brief Structure-of-arrays counterpart of AsvDynamics for a batch of K vehicles.
+     *
+     * Each array holds one row per vehicle and one column per coordinate or degree of freedom.
+     * Eigen arrays are column-major, so every column (e.g. the surge velocity of all vehicles) is
+     * contiguous in memory and the per-step kernels vectorise across vehicles.
+     *
+     * The mass, damping and stiffness matrices of the single-vehicle model are diagonal, so only
+     * their diagonals are stored.
+     */
+    struct AsvBatchDynamics {
+        /** @brief Position of each ASV in 3D space (in meters), K×3. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_COORDINATES> position;
+
+        /** @brief Attitude of each ASV (roll, pitch, yaw in radians; yaw counterclockwise from East), K×3. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_COORDINATES> attitude;
+
+        /** @brief Depth of submersion of each ASV (in meters), K×1. */
+        Eigen::ArrayXd submersion_depth;
+
+        /** @brief Diagonal of the mass and added mass matrix of each ASV, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> M;
+
+        /** @brief Diagonal of the damping (drag) coefficient matrix of each ASV, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> C;
+
+        /** @brief Diagonal of the hydrostatic stiffness matrix of each ASV, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> K;
+
+        /** @brief Displacement (deflection) in body-fixed frame, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> X;
+
+        /** @brief Velocity in body-fixed frame, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> V;
+
+        /** @brief Acceleration in body-fixed frame, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> A;
+
+        /** @brief Total net force acting on each ASV, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> F;
+
+        /** @brief Wave-induced force, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> F_wave;
+
+        /** @brief Force generated by the thrusters, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> F_thrust;
+
+        /** @brief Hydrodynamic drag (quadratic) force, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> F_drag;
+
+        /** @brief Hydrostatic restoring force, K×6. */
+        Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF> F_restoring;
+    };
+
+
+
+    /**
+     * @brief Steps a swarm of ASVs sharing one sea surface in lockstep.
+     *
+     * The batch holds the state of K vehicles in structure-of-arrays form (see AsvBatchDynamics)
+     * and advances all of them with one call to step_simulation(). The wave kernels loop over the
+     * N component waves and, for each component, evaluate all K vehicles with a single array
+     * expression, so the cost per step is dominated by streaming the state arrays rather than by
+     * per-object overhead.
+     *
+     * Every vehicle follows the same equations as Asv<N>::step_simulation(), and a vehicle in the
+     * batch reproduces the trajectory of an Asv<N> with the same inputs to within floating point
+     * rounding (see test/test_asv_batch.cpp). The intermediate arrays of a step are kept in a workspace 
+     * sized by add_vehicle(), so the steps do not allocate.
+     *
+     * @tparam N Number of regular component waves used to model the wave spectrum, or DYNAMIC to match the sea surface at run time.
+     * @tparam Trig Trigonometry policy used by the sea surface and the batched kernels 
+     *         (see Trigonometry::Exact and Trigonometry::Fast).
+     * @tparam Real Scalar type in which the component waves and the wave forces are evaluated. The 
+     *         vehicle states and the integration remain in double precision (see Asv).
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double>
+    class AsvBatch {
+
+        public:
+
+            /**
+             * @brief Constructs an empty batch of ASVs in a given sea environment.
+             *
+             * @param sea_surface Pointer to the irregular sea surface model shared by all vehicles (must not be nullptr).
+             *
+             * @throws std::invalid_argument if sea_surface is a nullptr.
+             */
+            AsvBatch(const SeaSurface<N, Trig, Real>* sea_surface) {
+                if(sea_surface == nullptr) {
+                    throw std::invalid_argument("Sea surface cannot be nullptr.");
+                }
+                this->sea_surface = sea_surface;
+            }
+
+
+            /**
+             * @brief Adds an ASV to the batch.
+             *
+             * The vehicle is placed vertically on the sea surface at the current batch time, matching the
+             * initialisation of Asv<N>.
+             *
+             * @param spec ASV geometric specifications.
+             * @param position Initial position of the ASV on the sea surface (in meters).
+             * @param attitude Initial attitude of the ASV (roll, pitch, yaw in radians, yaw is w.r.t. geographic north).
+             * @return size_t Index of the vehicle in the batch.
+             *
+             * @throws std::runtime_error If the computed added mass coefficient is invalid.
+             */
+            size_t add_vehicle(const AsvSpecification& spec,
+                               const Geometry::Coordinates3D& position,
+                               const Geometry::Coordinates3D& attitude) {
+                const AsvHullCoefficients hull {spec};
+                const Eigen::Index k = count;
+                resize(count + 1);
+                // Geometry
+                L_wl(k) = spec.L_wl;
+                B_wl(k) = spec.B_wl;
+                D(k) = spec.D;
+                T(k) = spec.T;
+                specs.push_back(spec);
+                // Hull constants
+                mass(k) = hull.mass;
+                I_roll(k) = hull.I_roll;
+                I_pitch(k) = hull.I_pitch;
+                I_yaw(k) = hull.I_yaw;
+                weight(k) = hull.weight;
+                added_mass_heave_factor(k) = hull.added_mass_heave_factor;
+                added_mass_roll_factor(k) = hull.added_mass_roll_factor;
+                added_mass_pitch_factor(k) = hull.added_mass_pitch_factor;
+                C_surge_factor(k) = hull.C_surge_factor;
+                C_sway_factor(k) = hull.C_sway_factor;
+                dynamics.C(k, 2) = hull.C_heave;
+                dynamics.C(k, 3) = hull.C_roll;
+                dynamics.C(k, 4) = hull.C_pitch;
+                dynamics.C(k, 5) = hull.C_yaw;
+                // Place the asv vertically in the correct position W.R.T sea_surface
+                dynamics.position(k, 0) = position.keys.x;
+                dynamics.position(k, 1) = position.keys.y;
+                dynamics.position(k, 2) = sea_surface->get_elevation(position, time);
+                dynamics.attitude(k, 0) = Geometry::normalise_angle_PI(attitude.keys.x);
+                dynamics.attitude(k, 1) = Geometry::normalise_angle_PI(attitude.keys.y);
+                // Note: yaw is provided as w.r.t North. Chage it to w.r.t East (x-axis) so as to match the intrinsic Z-Y-X rotation sequence.
+                dynamics.attitude(k, 2) = Geometry::switch_angle_frame(attitude.keys.z);
+                return static_cast<size_t>(k);
+            }
+
+
+            /**
+             * @brief Advances every ASV in the batch by one time step.
+             *
+             * @param thrust_positions Point of thrust application in body-fixed coordinates, one per vehicle.
+             * @param thrust_magnitudes Magnitude and direction of applied thrust, one per vehicle.
+             *
+             * @throws std::invalid_argument if the number of thrust inputs does not match the number of vehicles.
+             */
+            void step_simulation(const std::vector<Geometry::Coordinates3D>& thrust_positions,
+                                 const std::vector<Geometry::Coordinates3D>& thrust_magnitudes) {
+                if(thrust_positions.size() != count || thrust_magnitudes.size() != count) {
+                    throw std::invalid_argument("Thrust inputs must be provided for every vehicle in the batch.");
+                }
+                // Advance time
+                time += time_step_size/1000.0; // seconds
+                // Update submersion depth based on the vertical position relative to the current sea surface elevation and draught.
+                set_elevation_and_velocity(time);
+                dynamics.submersion_depth = (dynamics.position.col(2) - T) - workspace.elevation;
+                submerged = dynamics.submersion_depth < 0.0;
+                // Update vehicle dynamics
+                set_waterplane();
+                set_rotation();
+                // The wave force and added mass are computed at the rate of the wave force schedule and extrapolated in between.
+                if(wave_force_schedule.is_update_due(time)) {
+                    set_mass_and_wave_force();
+                    workspace.mass = dynamics.M.template middleCols<3>(2);
+                    wave_force_schedule.add_update(time, dynamics.F_wave, workspace.mass, max_encounter_freq);
+                } else {
+                    wave_force_schedule.get_mass(time, workspace.mass);
+                    dynamics.M.template middleCols<3>(2) = workspace.mass;
+                    wave_force_schedule.get_force(time, dynamics.F_wave);
+                    for(Eigen::Index i = 2; i < 5; ++i) {
+                        dynamics.F_wave.col(i) = submerged.select(dynamics.F_wave.col(i), 0.0);
+                    }
+                }
+                set_thrust(thrust_positions, thrust_magnitudes);
+                set_drag_force(workspace.sea_surface_velocity);
+                set_restoring_force();
+                set_net_force();
+                set_acceleration();
+                set_velocity();
+                set_deflection();
+                set_pose();
+            }
+
+
+            /**
+             * @brief Updates the ocean current affecting one ASV.
+             *
+             * @param k Index of the vehicle in the batch.
+             * @param ocean_current Zonal and meridional velocity components of the current (in m/s).
+             */
+            void set_ocean_current(const size_t k, const std::pair<double, double>& ocean_current) {
+                current(k, 0) = ocean_current.first;
+                current(k, 1) = ocean_current.second;
+            }
+
+
+            /**
+             * @brief Enables or disables halting of surge and sway motions of one ASV.
+             *
+             * @param k Index of the vehicle in the batch.
+             * @param set_halt Boolean flag to enable (true) or disable (false) surge and sway halt.
+             */
+            void set_surge_sway_halt(const size_t k, const bool set_halt) {
+                halt_surge_and_sway(k) = set_halt;
+            }
+
+
+            /**
+             * @brief Returns the number of vehicles in the batch.
+             */
+            size_t get_count() const {
+                return count;
+            }
+
+
+            /**
+             * @brief Retrieves the sea surface model shared by the vehicles in the batch.
+             */
+            const SeaSurface<N, Trig, Real>* get_sea_surface() const {
+                return sea_surface;
+            }
+
+
+            /**
+             * @brief Returns the geometric specification of one ASV.
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            AsvSpecification get_spec(const size_t k) const {
+                return specs[k];
+            }
+
+
+            /**
+             * @brief Returns the simulation time elapsed since the start (in seconds).
+             */
+            double get_time() const {
+                return time;
+            }
+
+
+            /**
+             * @brief Returns the time step size used in the simulation (in milliseconds).
+             */
+            double get_time_step_size() const {
+                return time_step_size;
+            }
+
+
+            /**
+             * @brief Sets the interval between computations of the wave force and the added mass of the vehicles.
+             *
+             * See Asv<N>::set_wave_force_update_interval().
+             *
+             * @param update_interval Interval in milliseconds (must be non-negative). Zero, the default, to compute 
+             *        them every time step.
+             *
+             * @throws std::invalid_argument if update_interval is negative.
+             */
+            void set_wave_force_update_interval(const double update_interval) {
+                wave_force_schedule.set_update_interval(update_interval);
+            }
+
+
+            /**
+             * @brief Returns the interval between computations of the wave force and the added mass (in milliseconds).
+             */
+            double get_wave_force_update_interval() const {
+                return wave_force_schedule.get_update_interval();
+            }
+
+
+            /**
+             * @brief Returns the current position of one ASV (in meters).
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            Geometry::Coordinates3D get_position(const size_t k) const {
+                return {dynamics.position(k, 0), dynamics.position(k, 1), dynamics.position(k, 2)};
+            }
+
+
+            /**
+             * @brief Returns the current attitude of one ASV (roll, pitch, yaw in radians).
+             *
+             * Follows the same convention as Asv<N>::get_attitude().
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            Geometry::Coordinates3D get_attitude(const size_t k) const {
+                return {dynamics.attitude(k, 0), dynamics.attitude(k, 1), dynamics.attitude(k, 2)};
+            }
+
+
+            /**
+             * @brief Returns the submersion depth of one ASV (in meters).
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            double get_submersion_depth(const size_t k) const {
+                return dynamics.submersion_depth(k);
+            }
+
+
+            /**
+             * @brief Returns the current velocity of one ASV.
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            Geometry::RigidBodyDOF get_velocity(const size_t k) const {
+                return get_dof(dynamics.V, k);
+            }
+
+
+            /**
+             * @brief Returns the current acceleration of one ASV.
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            Geometry::RigidBodyDOF get_acceleration(const size_t k) const {
+                return get_dof(dynamics.A, k);
+            }
+
+
+            /**
+             * @brief Returns the wave-induced force acting on one ASV (in N).
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            Geometry::RigidBodyDOF get_wave_force(const size_t k) const {
+                return get_dof(dynamics.F_wave, k);
+            }
+
+
+            /**
+             * @brief Returns the net force acting on one ASV (in N).
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            Geometry::RigidBodyDOF get_net_force(const size_t k) const {
+                return get_dof(dynamics.F, k);
+            }
+
+
+            /**
+             * @brief Returns the mass and added mass terms of one ASV for each degree of freedom.
+             *
+             * @param k Index of the vehicle in the batch.
+             */
+            Geometry::RigidBodyDOF get_mass(const size_t k) const {
+                return get_dof(dynamics.M, k);
+            }
+
+
+            /**
+             * @brief Returns the structure-of-arrays state of all vehicles in the batch.
+             */
+            const AsvBatchDynamics& get_dynamics() const {
+                return dynamics;
+            }
+
+
+        private:
+
+            /**
+             * @brief Resizes every per-vehicle array, preserving the existing vehicles.
+             *
+             * @param new_count New number of vehicles.
+             */
+            void resize(const size_t new_count) {
+                const Eigen::Index K = new_count;
+                auto grow = [&](auto& array) {
+                    const Eigen::Index old_rows = array.rows();
+                    array.conservativeResize(K, Eigen::NoChange);
+                    array.bottomRows(K - old_rows).setZero();
+                };
+                for(Eigen::ArrayXd* array : {&L_wl, &B_wl, &D, &T, &mass, &I_roll, &I_pitch, &I_yaw, &weight,
+                                             &added_mass_heave_factor, &added_mass_roll_factor, &added_mass_pitch_factor,
+                                             &C_surge_factor, &C_sway_factor, &dynamics.submersion_depth}) {
+                    grow(*array);
+                }
+                grow(current);
+                grow(dynamics.position);
+                grow(dynamics.attitude);
+                grow(dynamics.M);
+                grow(dynamics.C);
+                grow(dynamics.K);
+                grow(dynamics.X);
+                grow(dynamics.V);
+                grow(dynamics.A);
+                grow(dynamics.F);
+                grow(dynamics.F_wave);
+                grow(dynamics.F_thrust);
+                grow(dynamics.F_drag);
+                grow(dynamics.F_restoring);
+                const Eigen::Index old_rows = halt_surge_and_sway.rows();
+                halt_surge_and_sway.conservativeResize(K);
+                halt_surge_and_sway.tail(K - old_rows).setConstant(false);
+                // Arrays that are overwritten every step.
+                submerged.resize(K);
+                rotation.resize(K, Eigen::NoChange);
+                workspace.resize(K);
+                count = new_count;
+                // The last wave force updates do not cover the new vehicles.
+                wave_force_schedule.reset(dynamics.F_wave, workspace.mass);
+            }
+
+
+            /**
+             * @brief Copies one row of a K×6 array into a RigidBodyDOF.
+             */
+            static Geometry::RigidBodyDOF get_dof(const Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF>& array, const size_t k) {
+                Geometry::RigidBodyDOF dof;
+                for(size_t i = 0; i < Geometry::COUNT_DOF; ++i){
+                    dof.array[i] = array(k, i);
+                }
+                return dof;
+            }
+
+
+            /**
+             * @brief Computes the sea surface elevation and its vertical velocity under every vehicle into 
+             *        workspace.elevation and workspace.sea_surface_velocity. See SeaSurface::get_surface_kinematics().
+             *
+             * @param t Time in seconds since the start of the simulation.
+             */
+            void set_elevation_and_velocity(const double t) {
+                const RegularWave<N, Trig, Real>& waves = sea_surface->component_waves;
+                const auto x = dynamics.position.col(0);
+                const auto y = dynamics.position.col(1);
+                Eigen::Array<Real, Eigen::Dynamic, 1>& elevation = workspace.sum_elevation;
+                Eigen::Array<Real, Eigen::Dynamic, 1>& velocity = workspace.sum_velocity;
+                Eigen::Array<Real, Eigen::Dynamic, 1>& phase = workspace.phase;
+                Eigen::Array<Real, Eigen::Dynamic, 1>& trig = workspace.trig;
+                elevation.setZero();
+                velocity.setZero();
+                for(size_t i = 0; i < waves.count; ++i) {
+                    const double k_cos = waves.wave_number(i) * waves.heading_cos(i);
+                    const double k_sin = waves.wave_number(i) * waves.heading_sin(i);
+                    const double B = 2.0 * M_PI * waves.frequency(i) * t;
+                    workspace.phase_argument = k_cos * x + k_sin * y - B + waves.phase_lag(i);
+                    Trigonometry::reduce_phase(workspace.phase_argument, phase);
+                    Trig::cos(phase, trig);
+                    elevation += Real(waves.amplitude(i)) * trig;
+                    Trig::sin(phase, trig);
+                    velocity  += Real(2.0 * M_PI * waves.frequency(i) * waves.amplitude(i)) * trig;
+                }
+                workspace.elevation = elevation.template cast<double>();
+                workspace.sea_surface_velocity = velocity.template cast<double>();
+            }
+
+
+            /**
+             * @brief Computes the body-to-world rotation matrix (intrinsic Z-Y-X) of every vehicle.
+             *
+             * Row k of rotation holds the matrix of vehicle k in row-major order.
+             */
+            void set_rotation() {
+                const auto& attitude = dynamics.attitude;
+                Eigen::Array<double, Eigen::Dynamic, 9>& R = rotation;
+                Eigen::ArrayXd& c_r = workspace.cos_roll;
+                Eigen::ArrayXd& s_r = workspace.sin_roll;
+                Eigen::ArrayXd& c_p = workspace.cos_pitch;
+                Eigen::ArrayXd& s_p = workspace.sin_pitch;
+                Eigen::ArrayXd& c_y = workspace.cos_yaw;
+                Eigen::ArrayXd& s_y = workspace.sin_yaw;
+                Trig::cos(attitude.col(0), c_r);
+                Trig::sin(attitude.col(0), s_r);
+                Trig::cos(attitude.col(1), c_p);
+                Trig::sin(attitude.col(1), s_p);
+                Trig::cos(attitude.col(2), c_y);
+                Trig::sin(attitude.col(2), s_y);
+                R.col(0) = c_y * c_p;
+                R.col(1) = c_y * s_p * s_r - s_y * c_r;
+                R.col(2) = c_y * s_p * c_r + s_y * s_r;
+                R.col(3) = s_y * c_p;
+                R.col(4) = s_y * s_p * s_r + c_y * c_r;
+                R.col(5) = s_y * s_p * c_r - c_y * s_r;
+                R.col(6) = -s_p;
+                R.col(7) = c_p * s_r;
+                R.col(8) = c_p * c_r;
+            }
+
+
+            /**
+             * @brief Computes the mass matrix and the wave-induced force of every vehicle.
+             *
+             * Both depend on the encounter frequency of each component wave, so they are computed
+             * in the same pass over the N components. See Asv<N>::set_mass() and Asv<N>::set_wave_force().
+             */
+            void set_mass_and_wave_force() {
+                const RegularWave<N, Trig, Real>& waves = sea_surface->component_waves;
+                const auto x = dynamics.position.col(0);
+                const auto y = dynamics.position.col(1);
+                const auto yaw = dynamics.attitude.col(2);
+                const auto V_surge = dynamics.V.col(0);
+                // Waterplane ellipse at the current submersion depth (see set_waterplane()).
+                Workspace& w = workspace;
+                const Eigen::ArrayXd& a = w.a;
+                const Eigen::ArrayXd& b = w.b;
+                const Eigen::ArrayXd& A_waterplane = w.A_waterplane;
+                w.A_waterplane = M_PI/2 * a * b;
+                // Fore, aft, starboard and portside sampling points in the world frame.
+                w.x_forward   = x + a/2 * rotation.col(0);
+                w.y_forward   = y + a/2 * rotation.col(3);
+                w.x_aft       = x - a/2 * rotation.col(0);
+                w.y_aft       = y - a/2 * rotation.col(3);
+                w.x_starboard = x + b/2 * rotation.col(1);
+                w.y_starboard = y + b/2 * rotation.col(4);
+                w.x_portside  = x + b/2 * (rotation.col(0) - rotation.col(1));
+                w.y_portside  = y + b/2 * (rotation.col(3) - rotation.col(4));
+                // Accumulate over the component waves.
+                w.sum_encounter_freq_square.setZero();
+                w.sum_pressure_centre.setZero();
+                w.sum_pressure_trans.setZero();
+                w.sum_pressure_long.setZero();
+                max_encounter_freq = 0.0;
+                for(size_t i = 0; i < waves.count; ++i) {
+                    const double f = waves.frequency(i);
+                    Trig::cos((waves.heading(i) - yaw).template cast<Real>(), w.trig);
+                    w.encounter_freq = f - (f*f/Constants::G) * V_surge * w.trig.template cast<double>();
+                    w.sum_encounter_freq_square += w.encounter_freq.square();
+                    max_encounter_freq = std::max(max_encounter_freq, w.encounter_freq.abs().maxCoeff());
+                    // Wave number of the encountered wave from linear wave theory.
+                    w.wave_number = (2.0 * M_PI) * (2.0 * M_PI) * w.encounter_freq.square() / Constants::G;
+                    w.B = 2.0 * M_PI * w.encounter_freq * time - waves.phase_lag(i);
+                    const Real pressure_amplitude = -Constants::SEA_WATER_DENSITY * Constants::G * waves.amplitude(i);
+                    // The encountered waves propagate in the direction (PI/2 - heading), see Asv<N>::set_wave_force().
+                    auto set_pressure = [&](const auto& px, const auto& py, Eigen::Array<Real, Eigen::Dynamic, 1>& pressure) {
+                        w.phase_argument = w.wave_number * (px * waves.heading_sin(i) + py * waves.heading_cos(i)) - w.B;
+                        Trigonometry::reduce_phase(w.phase_argument, w.phase);
+                        Trig::cos(w.phase, pressure);
+                        pressure *= pressure_amplitude;
+                    };
+                    set_pressure(x, y, w.pressure);
+                    w.sum_pressure_centre += w.pressure;
+                    set_pressure(w.x_starboard, w.y_starboard, w.pressure);
+                    set_pressure(w.x_portside, w.y_portside, w.pressure_opposite);
+                    w.sum_pressure_trans += w.pressure - w.pressure_opposite;
+                    set_pressure(w.x_forward, w.y_forward, w.pressure);
+                    set_pressure(w.x_aft, w.y_aft, w.pressure_opposite);
+                    w.sum_pressure_long  += w.pressure - w.pressure_opposite;
+                }
+                // Mass matrix
+                // Averaged over the frequency bands of the spectrum, as the wave force below, so pruned components
+                // count as encountered at zero frequency.
+                const Eigen::ArrayXd& mean_encounter_freq_square = w.sum_encounter_freq_square;
+                w.sum_encounter_freq_square /= sea_surface->count_component_waves;
+                dynamics.M.col(0) = mass;
+                dynamics.M.col(1) = mass;
+                dynamics.M.col(2) = mass + added_mass_heave_factor * mean_encounter_freq_square;
+                dynamics.M.col(3) = I_roll + added_mass_roll_factor * mean_encounter_freq_square;
+                dynamics.M.col(4) = I_pitch + added_mass_pitch_factor * mean_encounter_freq_square;
+                dynamics.M.col(5) = I_yaw;
+                // Wave force, only applied to submerged vehicles.
+                // Averaged over the frequency bands of the spectrum, so pruned components count as contributing no pressure.
+                // The mean encounter frequency of the mass matrix is normalised the same way.
+                const double scale = 1.0/sea_surface->count_component_waves;
+                dynamics.F_wave.setZero();
+                dynamics.F_wave.col(2) = submerged.select(w.sum_pressure_centre.template cast<double>() * A_waterplane * scale, 0.0);
+                dynamics.F_wave.col(3) = submerged.select(w.sum_pressure_trans.template cast<double>() * A_waterplane * (b/8) * scale, 0.0);
+                dynamics.F_wave.col(4) = submerged.select(w.sum_pressure_long.template cast<double>() * A_waterplane * (a/8) * scale, 0.0);
+            }
+
+
+            /**
+             * @brief Computes the immersed depth and the semi-axes of the waterplane ellipse of every vehicle at the 
+             *        current submersion depth into workspace.c, workspace.a and workspace.b. Shared by the mass, wave 
+             *        force, drag and restoring force of a step.
+             */
+            void set_waterplane() {
+                workspace.c = -dynamics.submersion_depth.max(-D).min(0.0);
+                workspace.a = L_wl/2.0 * (1 - (D - workspace.c)/D).sqrt();
+                workspace.b = B_wl/2.0 * (1 - (D - workspace.c)/D).sqrt();
+            }
+
+
+            /**
+             * @brief Computes the propulsive thrust force and moments of every vehicle. See Asv<N>::set_thrust().
+             */
+            void set_thrust(const std::vector<Geometry::Coordinates3D>& thrust_positions,
+                            const std::vector<Geometry::Coordinates3D>& thrust_magnitudes) {
+                for(Eigen::Index k = 0; k < static_cast<Eigen::Index>(count); ++k) {
+                    const Geometry::Coordinates3D& p = thrust_positions[k];
+                    const Geometry::Coordinates3D& m = thrust_magnitudes[k];
+                    dynamics.F_thrust(k, 0) = m.keys.x;
+                    dynamics.F_thrust(k, 1) = m.keys.y;
+                    dynamics.F_thrust(k, 2) = m.keys.z;
+                    dynamics.F_thrust(k, 3) = m.keys.y * p.keys.z + m.keys.z * p.keys.y;
+                    dynamics.F_thrust(k, 4) = m.keys.x * p.keys.z + m.keys.z * p.keys.x;
+                    dynamics.F_thrust(k, 5) = m.keys.x * p.keys.y + m.keys.y * p.keys.x;
+                }
+                for(Eigen::Index i = 0; i < Geometry::COUNT_DOF; ++i) {
+                    dynamics.F_thrust.col(i) = submerged.select(dynamics.F_thrust.col(i), 0.0);
+                }
+            }
+
+
+            /**
+             * @brief Computes the hydrodynamic drag force of every vehicle. See Asv<N>::set_drag_force().
+             *
+             * @param sea_surface_velocity Vertical velocity of the sea surface under each vehicle at the current time.
+             */
+            void set_drag_force(const Eigen::ArrayXd& sea_surface_velocity) {
+                // Drag coefficients that vary with the submersion depth.
+                const Eigen::ArrayXd& c = workspace.c;
+                dynamics.C.col(0) = C_surge_factor * c;
+                dynamics.C.col(1) = C_sway_factor * c;
+                // Quadratic drag
+                dynamics.F_drag = -dynamics.C * dynamics.V * dynamics.V.abs();
+                // For heave the drag should be relative to the water surface velocity
+                Eigen::ArrayXd& relative_velocity = workspace.relative_velocity;
+                relative_velocity = dynamics.V.col(2) - sea_surface_velocity;
+                dynamics.F_drag.col(2) = -dynamics.C.col(2) * relative_velocity * relative_velocity.abs();
+                for(Eigen::Index i = 0; i < Geometry::COUNT_DOF; ++i) {
+                    dynamics.F_drag.col(i) = submerged.select(dynamics.F_drag.col(i), 0.0);
+                }
+            }
+
+
+            /**
+             * @brief Computes the hydrostatic restoring force of every vehicle. See Asv<N>::set_restoring_force().
+             */
+            void set_restoring_force() {
+                // Stiffness for the waterplane ellipse at the current submersion depth (see set_waterplane()).
+                const Eigen::ArrayXd& c = workspace.c;
+                const Eigen::ArrayXd& a = workspace.a;
+                const Eigen::ArrayXd& b = workspace.b;
+                dynamics.K.col(2) = M_PI * a * b * Constants::SEA_WATER_DENSITY * Constants::G;
+                dynamics.K.col(3) = M_PI/16.0 * a * b.cube() * Constants::SEA_WATER_DENSITY * Constants::G;
+                dynamics.K.col(4) = M_PI/16.0 * b * a.cube() * Constants::SEA_WATER_DENSITY * Constants::G;
+                // Buoyancy - weight for heave, stiffness for roll and pitch.
+                dynamics.F_restoring.col(2) = M_PI/6.0 * L_wl * B_wl * c * (3.0 - c/D) * Constants::SEA_WATER_DENSITY * Constants::G - weight;
+                dynamics.F_restoring.col(3) = -dynamics.K.col(3) * dynamics.attitude.col(0);
+                dynamics.F_restoring.col(4) = -dynamics.K.col(4) * dynamics.attitude.col(1);
+            }
+
+
+            /**
+             * @brief Computes the net force of every vehicle.
+             */
+            void set_net_force() {
+                dynamics.F = dynamics.F_thrust + dynamics.F_wave + dynamics.F_drag + dynamics.F_restoring;
+            }
+
+
+            /**
+             * @brief Computes the acceleration of every vehicle from the diagonal mass matrix.
+             */
+            void set_acceleration() {
+                dynamics.A = dynamics.M.inverse() * dynamics.F;
+            }
+
+
+            /**
+             * @brief Computes the velocity of every vehicle.
+             */
+            void set_velocity() {
+                dynamics.V += dynamics.A * time_step_size/1000.0;
+                dynamics.V.col(0) = halt_surge_and_sway.select(0.0, dynamics.V.col(0));
+                dynamics.V.col(1) = halt_surge_and_sway.select(0.0, dynamics.V.col(1));
+            }
+
+
+            /**
+             * @brief Computes the deflection of every vehicle, including the ocean current in the body frame.
+             */
+            void set_deflection() {
+                // Convert the global ocean current to the body frame (R^T * V_current_global)
+                dynamics.X = dynamics.V;
+                dynamics.X.col(0) += rotation.col(0) * current.col(0) + rotation.col(3) * current.col(1);
+                dynamics.X.col(1) += rotation.col(1) * current.col(0) + rotation.col(4) * current.col(1);
+                dynamics.X.col(2) += rotation.col(2) * current.col(0) + rotation.col(5) * current.col(1);
+                dynamics.X *= time_step_size/1000.0;
+            }
+
+
+            /**
+             * @brief Updates the position and attitude of every vehicle from its deflection.
+             */
+            void set_pose() {
+                // First set attitude
+                for(Eigen::Index i = 0; i < Geometry::COUNT_COORDINATES; ++i) {
+                    Trig::normalise_angle_PI(dynamics.attitude.col(i) + dynamics.X.col(3 + i), dynamics.attitude.col(i));
+                }
+                // Rotate deflection from body frame to global frame using the updated attitude.
+                set_rotation();
+                for(Eigen::Index i = 0; i < Geometry::COUNT_COORDINATES; ++i) {
+                    dynamics.position.col(i) += rotation.col(3*i)     * dynamics.X.col(0) +
+                                                rotation.col(3*i + 1) * dynamics.X.col(1) +
+                                                rotation.col(3*i + 2) * dynamics.X.col(2);
+                }
+            }
+
+
+        private:
+
+            /** @brief Pointer to the irregular sea surface model shared by all vehicles. */
+            const SeaSurface<N, Trig, Real>* sea_surface;
+
+            /** @brief Number of vehicles in the batch. */
+            size_t count {0};
+
+            /** @brief Simulation time (in seconds), shared by all vehicles. */
+            double time {0.0};
+
+            /** @brief Time step size (in milliseconds). */
+            const double time_step_size {40};
+
+            /** @brief Geometric specification of each vehicle. */
+            std::vector<AsvSpecification> specs;
+
+            // Per-vehicle hull constants
+            Eigen::ArrayXd L_wl;
+            Eigen::ArrayXd B_wl;
+            Eigen::ArrayXd D;
+            Eigen::ArrayXd T;
+            Eigen::ArrayXd mass;
+            Eigen::ArrayXd I_roll;
+            Eigen::ArrayXd I_pitch;
+            Eigen::ArrayXd I_yaw;
+            Eigen::ArrayXd weight;
+            Eigen::ArrayXd added_mass_heave_factor;
+            Eigen::ArrayXd added_mass_roll_factor;
+            Eigen::ArrayXd added_mass_pitch_factor;
+            Eigen::ArrayXd C_surge_factor;
+            Eigen::ArrayXd C_sway_factor;
+
+            /** @brief Zonal and meridional velocities of the ocean current at each vehicle (in m/s), K×2. */
+            Eigen::Array<double, Eigen::Dynamic, 2> current;
+
+            /** @brief Flags to halt surge and sway motions of each vehicle. */
+            Eigen::Array<bool, Eigen::Dynamic, 1> halt_surge_and_sway;
+
+            /** @brief Flags set for vehicles with a negative submersion depth in the current step. */
+            Eigen::Array<bool, Eigen::Dynamic, 1> submerged;
+
+            /** @brief Body-to-world rotation matrix of each vehicle, K×9 in row-major order. */
+            Eigen::Array<double, Eigen::Dynamic, 9> rotation;
+
+            /** @brief Dynamics and state variables of all vehicles. */
+            AsvBatchDynamics dynamics;
+
+            /** @brief Rate of the wave force and added mass updates, and the last updates. */
+            WaveForceSchedule<Eigen::Array<double, Eigen::Dynamic, Geometry::COUNT_DOF>, Eigen::Array<double, Eigen::Dynamic, 3>> wave_force_schedule;
+
+            /** @brief Largest magnitude of the encounter frequencies over the vehicles at the last wave force update (in Hz). */
+            double max_encounter_freq {0.0};
+
+            /**
+             * @brief Per-vehicle intermediate arrays of a step, sized with the batch so that the steps do not allocate.
+             */
+            struct Workspace {
+                // Sea surface under each vehicle
+                Eigen::ArrayXd elevation;
+                Eigen::ArrayXd sea_surface_velocity;
+                Eigen::Array<Real, Eigen::Dynamic, 1> sum_elevation;
+                Eigen::Array<Real, Eigen::Dynamic, 1> sum_velocity;
+                // Wave phases, in double precision and reduced to Real, and their cosines or sines
+                Eigen::ArrayXd phase_argument;
+                Eigen::Array<Real, Eigen::Dynamic, 1> phase;
+                Eigen::Array<Real, Eigen::Dynamic, 1> trig;
+                // Sines and cosines of the attitude
+                Eigen::ArrayXd cos_roll;
+                Eigen::ArrayXd sin_roll;
+                Eigen::ArrayXd cos_pitch;
+                Eigen::ArrayXd sin_pitch;
+                Eigen::ArrayXd cos_yaw;
+                Eigen::ArrayXd sin_yaw;
+                // Immersed depth, semi-axes and area of the waterplane ellipse
+                Eigen::ArrayXd c;
+                Eigen::ArrayXd a;
+                Eigen::ArrayXd b;
+                Eigen::ArrayXd A_waterplane;
+                // Pressure sampling points in the world frame
+                Eigen::ArrayXd x_forward;
+                Eigen::ArrayXd y_forward;
+                Eigen::ArrayXd x_aft;
+                Eigen::ArrayXd y_aft;
+                Eigen::ArrayXd x_starboard;
+                Eigen::ArrayXd y_starboard;
+                Eigen::ArrayXd x_portside;
+                Eigen::ArrayXd y_portside;
+                // Encountered waves and the wave pressures
+                Eigen::ArrayXd encounter_freq;
+                Eigen::ArrayXd wave_number;
+                Eigen::ArrayXd B;
+                Eigen::ArrayXd sum_encounter_freq_square;
+                Eigen::Array<Real, Eigen::Dynamic, 1> pressure;
+                Eigen::Array<Real, Eigen::Dynamic, 1> pressure_opposite;
+                Eigen::Array<Real, Eigen::Dynamic, 1> sum_pressure_centre;
+                Eigen::Array<Real, Eigen::Dynamic, 1> sum_pressure_trans;
+                Eigen::Array<Real, Eigen::Dynamic, 1> sum_pressure_long;
+                // Heave, roll and pitch mass terms, K×3, exchanged with the wave force schedule
+                Eigen::Array<double, Eigen::Dynamic, 3> mass;
+                // Heave velocity relative to the sea surface
+                Eigen::ArrayXd relative_velocity;
+
+                /**
+                 * @brief Resizes every array to K vehicles. The contents are not preserved.
+                 */
+                void resize(const Eigen::Index K) {
+                    for(Eigen::ArrayXd* array : {&elevation, &sea_surface_velocity, &phase_argument, &cos_roll, &sin_roll, &cos_pitch, &sin_pitch, 
+                                                 &cos_yaw, &sin_yaw, &c, &a, &b, &A_waterplane, &x_forward, &y_forward, &x_aft, &y_aft, 
+                                                 &x_starboard, &y_starboard, &x_portside, &y_portside, &encounter_freq, &wave_number, &B, 
+                                                 &sum_encounter_freq_square, &relative_velocity}) {
+                        array->setZero(K);
+                    }
+                    for(Eigen::Array<Real, Eigen::Dynamic, 1>* array : {&sum_elevation, &sum_velocity, &phase, &trig, &pressure, &pressure_opposite, 
+                                                                        &sum_pressure_centre, &sum_pressure_trans, &sum_pressure_long}) {
+                        array->setZero(K);
+                    }
+                    mass.setZero(K, Eigen::NoChange);
+                }
+            };
+
+            /** @brief Intermediate arrays of the steps. */
+            Workspace workspace;
+    };
+
+}
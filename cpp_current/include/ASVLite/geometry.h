@@ -98,8 +98,8 @@ namespace ASVLite {
          * @return double Normalized angle in radians.
          */
         inline double normalise_angle_PI(const double angle) {
-            // Reduce the angle if greater than 2PI
-            double value = fmod(angle, 2.0*M_PI);
+            // Reduce the angle if greater than 2PI. fmod returns angles within 2PI unchanged, so skip it for them.
+            double value = (std::abs(angle) < 2.0*M_PI) ? angle : fmod(angle, 2.0*M_PI);
             // Set to range (-PI, PI]
             if(value > M_PI)
             {
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <Eigen/Dense>
+
+namespace ASVLite {
+
+    /**
+     * @brief Time integration policies for Asv.
+     *
+     * Asv takes a policy as a template parameter, holds an instance of it and befriends it. Each call
+     * of Asv::step_simulation() calls the policy's step(vehicle, step_size) to advance the vehicle by
+     * step_size seconds. The Runge-Kutta schemes work on the state vector of the vehicle through
+     *  - get_state(), the state vector at the current time,
+     *  - set_state(state, time), to move the vehicle to a state and a time, and
+     *  - get_state_derivative(state, time), the rate of change of the state vector, which also moves the
+     *    vehicle to the state and the time and computes its forces there.
+     */
+    namespace Integration {
+
+        /**
+         * @brief State vector of a vehicle.
+         *
+         * Position x, y, z (m), attitude roll, pitch, yaw (radian, yaw w.r.t East) and the velocity in
+         * surge, sway, heave, roll, pitch and yaw in the body-fixed frame.
+         */
+        using State = Eigen::Matrix<double, 12, 1>;
+
+
+        /**
+         * @brief Semi-implicit (symplectic) Euler, one force evaluation per step.
+         *
+         * The velocity is advanced with the acceleration at the start of the step, and the pose with the
+         * new velocity. This is the original scheme of the model and the default. It is stable at the
+         * default 40 ms step in all sea states, but the error grows linearly with the step size.
+         */
+        struct SemiImplicitEuler {
+
+            /**
+             * @brief Advances a vehicle by step_size seconds.
+             */
+            template<typename Vehicle>
+            void step(Vehicle& vehicle, const double step_size) const {
+                vehicle.set_dynamics(vehicle.get_time() + step_size);
+                vehicle.set_velocity(step_size);
+                vehicle.set_deflection(step_size);
+                vehicle.set_pose();
+            }
+        };
+
+
+        /**
+         * @brief Classical fourth order Runge-Kutta, four force evaluations per step.
+         *
+         * The forces reported by the vehicle after a step are those of the last stage, evaluated at the
+         * state predicted for the end of the step.
+         */
+        struct RungeKutta4 {
+
+            /**
+             * @brief Advances a vehicle by step_size seconds.
+             */
+            template<typename Vehicle>
+            void step(Vehicle& vehicle, const double step_size) const {
+                const double h = step_size;
+                const double t = vehicle.get_time();
+                const State y = vehicle.get_state();
+                const State k_1 = vehicle.get_state_derivative(y, t);
+                const State k_2 = vehicle.get_state_derivative(y + h/2.0 * k_1, t + h/2.0);
+                const State k_3 = vehicle.get_state_derivative(y + h/2.0 * k_2, t + h/2.0);
+                const State k_4 = vehicle.get_state_derivative(y + h * k_3, t + h);
+                vehicle.set_state(y + h/6.0 * (k_1 + 2.0*k_2 + 2.0*k_3 + k_4), t + h);
+            }
+        };
+
+
+        /**
+         * @brief Adaptive Bogacki-Shampine 3(2) scheme with embedded error control.
+         *
+         * Each call of step() covers step_size seconds with as many sub-steps as the error tolerance
+         * requires. The third order solution is advanced and the difference from the embedded second order
+         * solution estimates the local error. A sub-step is accepted when the root mean square of the error,
+         * scaled component-wise by tolerance × (1 + |state|), is at most one, and the next sub-step is sized
+         * from the error. The last stage of an accepted sub-step is the first stage of the next, so a
+         * sub-step costs three force evaluations. The sub-step size carries over between calls.
+         *
+         * The forces reported by the vehicle after a step are those at the end of the step.
+         *
+         * @ref Bogacki and Shampine, A 3(2) pair of Runge-Kutta formulas, Applied Mathematics Letters, 1989.
+         */
+        class Adaptive {
+
+            public:
+
+                /**
+                 * @brief Constructs the scheme.
+                 *
+                 * @param tolerance Relative and absolute local error tolerance per sub-step (must be positive).
+                 * @param min_step_size Smallest sub-step in seconds (must be positive). A sub-step of this size is
+                 *        accepted whatever its error, so that discontinuities in the forces (e.g. the hull leaving
+                 *        the water) cannot stall the integration.
+                 *
+                 * @throws std::invalid_argument if tolerance or min_step_size is not positive.
+                 */
+                explicit Adaptive(const double tolerance = 1e-6, const double min_step_size = 1e-4) :
+                tolerance {tolerance},
+                min_step_size {min_step_size} {
+                    if(tolerance <= 0.0) {
+                        throw std::invalid_argument("Integration tolerance must be positive.");
+                    }
+                    if(min_step_size <= 0.0) {
+                        throw std::invalid_argument("Minimum step size must be positive.");
+                    }
+                }
+
+
+                /**
+                 * @brief Advances a vehicle by step_size seconds.
+                 */
+                template<typename Vehicle>
+                void step(Vehicle& vehicle, const double step_size) {
+                    const double t_end = vehicle.get_time() + step_size;
+                    double t = vehicle.get_time();
+                    State y = vehicle.get_state();
+                    State k_1 = vehicle.get_state_derivative(y, t);
+                    if(sub_step_size <= 0.0) {
+                        sub_step_size = step_size;
+                    }
+                    bool is_end = false;
+                    while(!is_end) {
+                        // Shorten the last sub-step to end on t_end.
+                        const bool is_last = (t + sub_step_size >= t_end);
+                        const double h = is_last ? t_end - t : sub_step_size;
+                        const double t_next = is_last ? t_end : t + h;
+                        const State k_2 = vehicle.get_state_derivative(y + 0.5 * h * k_1, t + 0.5 * h);
+                        const State k_3 = vehicle.get_state_derivative(y + 0.75 * h * k_2, t + 0.75 * h);
+                        const State y_next = y + h * (2.0/9.0 * k_1 + 1.0/3.0 * k_2 + 4.0/9.0 * k_3);
+                        const State k_4 = vehicle.get_state_derivative(y_next, t_next);
+                        // Difference from the second order solution, y + h × (7/24 k_1 + 1/4 k_2 + 1/3 k_3 + 1/8 k_4).
+                        const State error = h * (-5.0/72.0 * k_1 + 1.0/12.0 * k_2 + 1.0/9.0 * k_3 - 1.0/8.0 * k_4);
+                        const State scale = tolerance * (State::Ones() + y.cwiseAbs().cwiseMax(y_next.cwiseAbs()));
+                        const double error_norm = std::sqrt(error.cwiseQuotient(scale).squaredNorm() / error.size());
+                        const bool is_accepted = (error_norm <= 1.0 or h <= min_step_size);
+                        // Next sub-step, limited to a change of 1/5 to 5 times.
+                        const double factor = (error_norm > 0.0) ? std::clamp(0.9 * std::pow(error_norm, -1.0/3.0), 0.2, 5.0) : 5.0;
+                        const double next_step_size = std::max(h * factor, min_step_size);
+                        if(is_accepted) {
+                            t = t_next;
+                            y = y_next;
+                            k_1 = k_4;
+                            is_end = is_last;
+                            // A last sub-step shortened to end on t_end says little about the size of the next.
+                            sub_step_size = is_last ? std::max(sub_step_size, next_step_size) : next_step_size;
+                        } else {
+                            sub_step_size = next_step_size;
+                        }
+                    }
+                    // The vehicle was last moved to the accepted state at t_end, in the evaluation of k_4.
+                }
+
+
+                /**
+                 * @brief Returns the size of the next sub-step in seconds, or zero before the first step.
+                 */
+                double get_sub_step_size() const {
+                    return sub_step_size;
+                }
+
+
+                /**
+                 * @brief Returns the relative and absolute local error tolerance per sub-step.
+                 */
+                double get_tolerance() const {
+                    return tolerance;
+                }
+
+
+                /**
+                 * @brief Returns the smallest sub-step in seconds.
+                 */
+                double get_min_step_size() const {
+                    return min_step_size;
+                }
+
+
+            private:
+
+                // Not const, so that the scheme is copy-assignable and restored with the state of a vehicle (see AsvState).
+
+                /** @brief Relative and absolute local error tolerance per sub-step. */
+                double tolerance;
+
+                /** @brief Smallest sub-step in seconds. */
+                double min_step_size;
+
+                /** @brief Size of the next sub-step in seconds. */
+                double sub_step_size {0.0};
+        };
+
+    }
+
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <Eigen/Dense>
+
+namespace ASVLite {
+
+    /**
+     * @brief Structure policies for the 6×6 mass, damping and stiffness matrices of Asv.
+     *
+     * Asv takes a policy as a template parameter and stores M, C and K as policy matrices. A policy
+     * matrix holds only the entries its structure allows, and provides:
+     * - operator()(i, j) to read an entry (zero outside the structure),
+     * - set(i, j, value) to write an entry, throwing std::invalid_argument outside the structure,
+     * - multiply(x) for the product with a 6×1 vector, and
+     * - solve(b) for the solution of M x = b.
+     *
+     * The degrees of freedom are indexed surge, sway, heave, roll, pitch, yaw.
+     */
+    namespace MatrixStructure {
+
+        /** @brief Vector of the six degrees of freedom. */
+        using Vector6d = Eigen::Matrix<double, 6, 1>;
+
+
+        /**
+         * @brief Diagonal matrix, for a model with no coupling between the degrees of freedom.
+         *
+         * Products and solves are six multiplications or divisions.
+         */
+        class Diagonal {
+
+            public:
+
+                /**
+                 * @brief Returns the entry at row i and column j.
+                 */
+                double operator()(const size_t i, const size_t j) const {
+                    return (i == j) ? diagonal(i) : 0.0;
+                }
+
+
+                /**
+                 * @brief Sets the entry at row i and column j.
+                 *
+                 * @throws std::invalid_argument if the entry is off the diagonal.
+                 */
+                void set(const size_t i, const size_t j, const double value) {
+                    if(i != j) {
+                        throw std::invalid_argument("Diagonal matrix has no off-diagonal entries.");
+                    }
+                    diagonal(i) = value;
+                }
+
+
+                /**
+                 * @brief Returns the product of the matrix with a vector.
+                 */
+                Vector6d multiply(const Vector6d& x) const {
+                    return diagonal.cwiseProduct(x);
+                }
+
+
+                /**
+                 * @brief Returns x such that M x = b. All diagonal entries must be non-zero.
+                 */
+                Vector6d solve(const Vector6d& b) const {
+                    return b.cwiseQuotient(diagonal);
+                }
+
+
+            private:
+
+                /** @brief Diagonal entries. */
+                Vector6d diagonal = Vector6d::Zero();
+        };
+
+
+        /**
+         * @brief Block diagonal matrix coupling the longitudinal and the lateral degrees of freedom.
+         *
+         * For a hull symmetric about its centreline the longitudinal motions (surge, heave, pitch) do not
+         * couple with the lateral motions (sway, roll, yaw), so each matrix splits into two 3×3 blocks.
+         * Entries within a block may be set freely.
+         *
+         * solve() uses the inverses of the two blocks, which are computed on the first solve after an
+         * entry changes and reused until the next change. set() of an unchanged value keeps the inverses.
+         *
+         * @ref Handbook of Marine Craft Hydrodynamics and Motion Control, T. I. Fossen, section 7.3.
+         */
+        class Coupled {
+
+            public:
+
+                /**
+                 * @brief Returns the entry at row i and column j.
+                 */
+                double operator()(const size_t i, const size_t j) const {
+                    return (BLOCK[i] == BLOCK[j]) ? blocks[BLOCK[i]](POSITION[i], POSITION[j]) : 0.0;
+                }
+
+
+                /**
+                 * @brief Sets the entry at row i and column j.
+                 *
+                 * @throws std::invalid_argument if the entry couples a longitudinal with a lateral degree of freedom.
+                 */
+                void set(const size_t i, const size_t j, const double value) {
+                    if(BLOCK[i] != BLOCK[j]) {
+                        throw std::invalid_argument("Coupled matrix has no entries between longitudinal and lateral degrees of freedom.");
+                    }
+                    double& entry = blocks[BLOCK[i]](POSITION[i], POSITION[j]);
+                    if(entry != value) {
+                        entry = value;
+                        is_factorised = false;
+                    }
+                }
+
+
+                /**
+                 * @brief Returns the product of the matrix with a vector.
+                 */
+                Vector6d multiply(const Vector6d& x) const {
+                    return from_blocks(blocks[0] * longitudinal(x), blocks[1] * lateral(x));
+                }
+
+
+                /**
+                 * @brief Returns x such that M x = b. Both blocks must be invertible.
+                 */
+                Vector6d solve(const Vector6d& b) const {
+                    if(!is_factorised) {
+                        inverses[0] = blocks[0].inverse();
+                        inverses[1] = blocks[1].inverse();
+                        is_factorised = true;
+                    }
+                    return from_blocks(inverses[0] * longitudinal(b), inverses[1] * lateral(b));
+                }
+
+
+            private:
+
+                /** @brief Block of each degree of freedom, 0 for longitudinal and 1 for lateral. */
+                static constexpr size_t BLOCK[6] {0, 1, 0, 1, 0, 1};
+
+                /** @brief Row or column of each degree of freedom within its block. */
+                static constexpr size_t POSITION[6] {0, 0, 1, 1, 2, 2};
+
+                /** @brief Surge, heave and pitch components of a vector. */
+                static Eigen::Vector3d longitudinal(const Vector6d& x) {
+                    return {x(0), x(2), x(4)};
+                }
+
+                /** @brief Sway, roll and yaw components of a vector. */
+                static Eigen::Vector3d lateral(const Vector6d& x) {
+                    return {x(1), x(3), x(5)};
+                }
+
+                /** @brief Vector of the six degrees of freedom from its longitudinal and lateral components. */
+                static Vector6d from_blocks(const Eigen::Vector3d& longitudinal, const Eigen::Vector3d& lateral) {
+                    Vector6d x;
+                    x << longitudinal(0), lateral(0), longitudinal(1), lateral(1), longitudinal(2), lateral(2);
+                    return x;
+                }
+
+                /** @brief Longitudinal and lateral blocks. */
+                Eigen::Matrix3d blocks[2] {Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero()};
+
+                /** @brief Inverses of the blocks, valid while is_factorised is true. */
+                mutable Eigen::Matrix3d inverses[2];
+
+                /** @brief True if inverses is up to date with blocks. */
+                mutable bool is_factorised {false};
+        };
+
+    }
+
+}
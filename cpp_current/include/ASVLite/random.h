@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace ASVLite {
+
+    /**
+     * @brief Counter-based random number generation.
+     *
+     * A counter-based generator maps a key and a counter directly to a random value, with no state carried
+     * from one draw to the next. The value drawn for (seed, index) is the same whatever thread draws it
+     * and whatever was drawn before, so random parameters can be generated in any order and in parallel
+     * with bit-identical results.
+     */
+    namespace Random {
+
+        /**
+         * @brief Philox4x32-10 block function.
+         *
+         * Maps a 128 bit counter and a 64 bit key to 128 random bits with 10 rounds of multiply-xor mixing.
+         * Passes the BigCrush statistical tests for any key and any sequence of counters.
+         *
+         * @ref Salmon, Moraes, Dror and Shaw, Parallel random numbers: as easy as 1, 2, 3, SC11, 2011.
+         */
+        inline std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key) {
+            constexpr uint32_t M_0 = 0xD2511F53;
+            constexpr uint32_t M_1 = 0xCD9E8D57;
+            constexpr uint32_t W_0 = 0x9E3779B9; // Golden ratio
+            constexpr uint32_t W_1 = 0xBB67AE85; // sqrt(3) - 1
+            for(int round = 0; round < 10; ++round) {
+                const uint64_t product_0 = uint64_t(M_0) * counter[0];
+                const uint64_t product_1 = uint64_t(M_1) * counter[2];
+                counter = {
+                    uint32_t(product_1 >> 32) ^ counter[1] ^ key[0],
+                    uint32_t(product_1),
+                    uint32_t(product_0 >> 32) ^ counter[3] ^ key[1],
+                    uint32_t(product_0)
+                };
+                key[0] += W_0;
+                key[1] += W_1;
+            }
+            return counter;
+        }
+
+
+        /**
+         * @brief Returns a random number uniformly distributed in [0, 1) for a seed, a stream and an index.
+         *
+         * @param seed Seed of the random numbers.
+         * @param stream Independent sequence within the seed, to separate different uses of the same seed.
+         * @param index Position of the number in the sequence.
+         * @return double Random number with 53 random bits.
+         */
+        inline double get_uniform(const uint64_t seed, const uint32_t stream, const uint64_t index) {
+            const std::array<uint32_t, 4> bits = philox4x32({uint32_t(index), uint32_t(index >> 32), stream, 0},
+                                                            {uint32_t(seed), uint32_t(seed >> 32)});
+            const uint64_t mantissa = (uint64_t(bits[0]) << 21) ^ (bits[1] >> 11); // 53 bits
+            return mantissa * 0x1.0p-53;
+        }
+
+
+        /** @brief Stream of the phase lags of the component waves of SeaSurface. */
+        constexpr uint32_t STREAM_COMPONENT_PHASE = 0;
+
+        /** @brief Stream of the phase lags of the wavenumber bins of SeaSurfaceTile. */
+        constexpr uint32_t STREAM_TILE_PHASE = 1;
+
+    }
+
+}
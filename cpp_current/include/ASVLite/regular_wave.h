@@ -1,14 +1,103 @@
 #pragma once
 
 #include <cmath>
+#include <array>
+#include <complex>
 #include <stdexcept>
 #include <Eigen/Dense>
 #include "ASVLite/constants.h"
 #include "geometry.h"
+#include "trigonometry.h"
 
 namespace ASVLite {
 
+    /**
+     * @brief Component count for collections of waves whose size is chosen at run time.
+     *
+     * RegularWave<DYNAMIC>, SeaSurface<DYNAMIC>, Asv<DYNAMIC> and AsvBatch<DYNAMIC> take the number of
+     * component waves as a constructor argument, so vehicles with coarse and fine spectra have the same
+     * type. The component parameters are held in heap buffers that Eigen aligns for SIMD, padded up 
+     * to one of the kernel sizes (see get_padded_count()) with components of zero amplitude and zero 
+     * frequency, which contribute nothing to the elevation, pressure or encounter frequency. The per-step 
+     * kernels are dispatched on the padded size to instantiations with that size fixed at compile time
+     * (see dispatch_component_count()), so they are unrolled and allocation free like the fixed size
+     * classes. Beyond the largest kernel size, 64 components, the kernels run with Eigen::Dynamic arrays
+     * whose temporaries are allocated on the heap on every call.
+     */
+    constexpr size_t DYNAMIC = 0;
+
+    /**
+     * @brief Eigen size for a collection of N component waves, Eigen::Dynamic for N = DYNAMIC.
+     */
     template<size_t N>
+    constexpr int EIGEN_SIZE = (N == DYNAMIC) ? Eigen::Dynamic : static_cast<int>(N);
+
+    /**
+     * @brief Component counts for which the kernels of the DYNAMIC classes are pre-instantiated.
+     */
+    constexpr std::array<size_t, 6> KERNEL_SIZES {8, 16, 24, 32, 48, 64};
+
+    /**
+     * @brief Returns the length of the padded buffers that hold count component waves.
+     *
+     * The smallest kernel size that is not less than count, or count rounded up to a multiple of 8 
+     * beyond the largest kernel size.
+     */
+    constexpr size_t get_padded_count(const size_t count) {
+        for(const size_t size : KERNEL_SIZES) {
+            if(count <= size) {
+                return size;
+            }
+        }
+        return (count + 7) / 8 * 8;
+    }
+
+    /**
+     * @brief Calls a kernel with the component count fixed at compile time.
+     *
+     * The kernel is a generic lambda with an int template parameter M, the Eigen size of the arrays 
+     * it works on, e.g. [&]<int M>() { ... }. For a fixed N it is called with M = N. For N = DYNAMIC 
+     * it is called with the kernel size that equals the padded buffer length, or with M = Eigen::Dynamic 
+     * if the length is not one of KERNEL_SIZES, in which case the temporaries of the kernel are allocated.
+     *
+     * @param size Length of the component buffers.
+     * @param kernel Kernel to call.
+     * @return The value returned by the kernel.
+     */
+    template<size_t N, typename Kernel>
+    decltype(auto) dispatch_component_count(const size_t size, Kernel&& kernel) {
+        if constexpr (N != DYNAMIC) {
+            return kernel.template operator()<static_cast<int>(N)>();
+        } else {
+            switch(size) {
+                case 8:  return kernel.template operator()<8>();
+                case 16: return kernel.template operator()<16>();
+                case 24: return kernel.template operator()<24>();
+                case 32: return kernel.template operator()<32>();
+                case 48: return kernel.template operator()<48>();
+                case 64: return kernel.template operator()<64>();
+                default: return kernel.template operator()<Eigen::Dynamic>();
+            }
+        }
+    }
+
+    /**
+     * @brief Read-only view of a buffer of component wave parameters as an array of Eigen size M.
+     */
+    template<int M>
+    using ComponentArray = Eigen::Map<const Eigen::Array<double, M, 1>>;
+
+
+    /**
+     * @brief A collection of N regular (sinusoidal) ocean waves.
+     * 
+     * @tparam N Number of regular waves, or DYNAMIC to set the number at run time.
+     * @tparam Trig Trigonometry policy used to evaluate the waves (see Trigonometry::Exact and Trigonometry::Fast).
+     * @tparam Real Scalar type in which the elevation and pressure of the components are evaluated. 
+     *         The wave parameters and the phases are always held in double precision, as the phases 
+     *         grow with time and distance (see Trigonometry::reduce_phase()).
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double>
     class RegularWave {
 
         public:
@@ -20,19 +109,51 @@ namespace ASVLite {
              * @param frequency Wave frequencies in Hz.
              * @param phase_lag Phase lags in radians.
              * @param heading Directions of wave propagation in radians, clockwise from geographic north.
+             * 
+             * @throws std::invalid_argument if N is DYNAMIC and the vectors differ in length.
              */
-            RegularWave(const Eigen::Vector<double, N> amplitude, 
-                        const Eigen::Vector<double, N> frequency, 
-                        const Eigen::Vector<double, N> phase_lag, 
-                        const Eigen::Vector<double, N> heading) :
-            amplitude {amplitude},
-            frequency {frequency},
-            phase_lag {phase_lag},
-            heading {heading.unaryExpr(&Geometry::switch_angle_frame)}, // Covert angle to counter-clockwise from geographic east (x-axis). 
-            height {2.0 * amplitude},
-            time_period {frequency.array().inverse()},
+            RegularWave(const Eigen::Vector<double, EIGEN_SIZE<N>> amplitude, 
+                        const Eigen::Vector<double, EIGEN_SIZE<N>> frequency, 
+                        const Eigen::Vector<double, EIGEN_SIZE<N>> phase_lag, 
+                        const Eigen::Vector<double, EIGEN_SIZE<N>> heading) :
+            count {get_count(amplitude, frequency, phase_lag, heading)},
+            amplitude {pad(amplitude)},
+            frequency {pad(frequency)},
+            phase_lag {pad(phase_lag)},
+            heading {pad(heading).unaryExpr(&Geometry::switch_angle_frame)}, // Covert angle to counter-clockwise from geographic east (x-axis). 
+            height {2.0 * this->amplitude},
+            time_period {this->frequency.array().inverse()},
             wave_length {(ASVLite::Constants::G * time_period.array().square())/(2.0 * M_PI)}, 
-            wave_number {(2.0 * M_PI) * wave_length.array().inverse()} {
+            wave_number {(2.0 * M_PI) * wave_length.array().inverse()},
+            heading_cos {this->heading.array().cos()},
+            heading_sin {this->heading.array().sin()} {
+            }
+
+
+            /**
+             * @brief Replaces the amplitudes, phase lags and headings of the waves in place, keeping their frequencies.
+             * 
+             * Lets the sea state change during a simulation without rebuilding the waves (see SeaStateTimeline). 
+             * Does not allocate.
+             * 
+             * @param amplitude Wave amplitudes in meters, one per component.
+             * @param phase_lag Phase lags in radians, one per component.
+             * @param heading Directions of wave propagation in radians, clockwise from geographic north, one per component.
+             * 
+             * @throws std::invalid_argument if the vectors do not have count entries.
+             */
+            void set_sea_state(const Eigen::Ref<const Eigen::VectorXd>& amplitude, 
+                               const Eigen::Ref<const Eigen::VectorXd>& phase_lag, 
+                               const Eigen::Ref<const Eigen::VectorXd>& heading) {
+                if(static_cast<size_t>(amplitude.size()) != count or static_cast<size_t>(phase_lag.size()) != count or static_cast<size_t>(heading.size()) != count) {
+                    throw std::invalid_argument("Wave parameter vectors must have one entry per component.");
+                }
+                this->amplitude.head(count) = amplitude;
+                this->phase_lag.head(count) = phase_lag;
+                this->heading.head(count) = heading.unaryExpr(&Geometry::switch_angle_frame); // Covert angle to counter-clockwise from geographic east (x-axis). 
+                height.head(count) = 2.0 * amplitude;
+                heading_cos.head(count) = this->heading.head(count).array().cos();
+                heading_sin.head(count) = this->heading.head(count).array().sin();
             }
 
 
@@ -41,11 +162,11 @@ namespace ASVLite {
              * 
              * @param location 3D coordinates (in meters) where the wave phase is evaluated.
              * @param time Time in seconds since the start of the simulation (must be non-negative).
-             * @return Eigen::Vector<double, N> Wave phase in radians at the given location and time.
+             * @return Eigen::Vector<double, EIGEN_SIZE<N>> Wave phase in radians at the given location and time.
              * 
              * @throws std::invalid_argument if time is negative.
              */
-            Eigen::Vector<double, N> get_phase(const ASVLite::Geometry::Coordinates3D& location, const double time) const {
+            Eigen::Vector<double, EIGEN_SIZE<N>> get_phase(const ASVLite::Geometry::Coordinates3D& location, const double time) const {
                 if(time < 0.0) {
                     throw std::invalid_argument("Time cannot be negative.");
                 }
@@ -53,8 +174,8 @@ namespace ASVLite {
                 // where:
                 // A = wave_number * (x * cos(direction) + y * sin(direction))
                 // B = 2 * PI * frequency * time
-                const Eigen::Vector<double, N> A = wave_number.array() * (location.keys.x * heading.array().cos() + location.keys.y * heading.array().sin());
-                const Eigen::Vector<double, N> B = 2.0 * M_PI * frequency * time;
+                const Eigen::Vector<double, EIGEN_SIZE<N>> A = wave_number.array() * (location.keys.x * heading_cos.array() + location.keys.y * heading_sin.array());
+                const Eigen::Vector<double, EIGEN_SIZE<N>> B = 2.0 * M_PI * frequency * time;
                 return (A - B + phase_lag);
             }
 
@@ -64,16 +185,16 @@ namespace ASVLite {
              * 
              * @param location 3D coordinates (in meters) where the elevation is evaluated.
              * @param time Time in seconds since the start of the simulation (must be non-negative).
-             * @return Eigen::Vector<double, N> Wave elevation in meters at the given location and time.
+             * @return Eigen::Vector<Real, EIGEN_SIZE<N>> Wave elevation in meters at the given location and time.
              * 
              * @throws std::invalid_argument if time is negative.
              */
-            Eigen::Vector<double, N> get_elevation(const ASVLite::Geometry::Coordinates3D& location, const double time) const {
+            Eigen::Vector<Real, EIGEN_SIZE<N>> get_elevation(const ASVLite::Geometry::Coordinates3D& location, const double time) const {
                 if(time < 0.0) {
                     throw std::invalid_argument("Time cannot be negative.");
                 }
-                const Eigen::Vector<double, N> wave_phase = get_phase(location, time);
-                return (amplitude.array() * wave_phase.array().cos());
+                const Eigen::Vector<double, EIGEN_SIZE<N>> wave_phase = get_phase(location, time);
+                return (amplitude.array().template cast<Real>() * Trig::cos(Trigonometry::reduce_phase<Real>(wave_phase.array())));
             }
 
 
@@ -85,42 +206,247 @@ namespace ASVLite {
              * 
              * @param location 3D coordinates (in meters) where the pressure is evaluated.
              * @param time Time in seconds since the start of the simulation (must be non-negative).
-             * @return Eigen::Vector<double, N> Wave pressure amplitude in N/m² at the specified location and time.
+             * @return Eigen::Vector<Real, EIGEN_SIZE<N>> Wave pressure amplitude in N/m² at the specified location and time.
              */
-            Eigen::Vector<double, N> get_wave_pressure(const Geometry::Coordinates3D& location, const double time) const {
+            Eigen::Vector<Real, EIGEN_SIZE<N>> get_wave_pressure(const Geometry::Coordinates3D& location, const double time) const {
 
-                const Eigen::Vector<double, N> phase = get_phase(location, time);
-                return -Constants::SEA_WATER_DENSITY * Constants::G * amplitude.array() * phase.array().cos(); 
+                const Eigen::Vector<double, EIGEN_SIZE<N>> phase = get_phase(location, time);
+                return Real(-Constants::SEA_WATER_DENSITY * Constants::G) * amplitude.array().template cast<Real>() * Trig::cos(Trigonometry::reduce_phase<Real>(phase.array())); 
             }
 
             
             // Input variables
             // ---------------
+            /** @brief Number of wave components. For N = DYNAMIC the vectors below are padded beyond count (see DYNAMIC). */
+            const size_t count;
+
+            // Amplitude, phase lag and heading, and the variables calculated from them, change only through set_sea_state().
+
             /** @brief Amplitudes of the wave components (m). */
-            const Eigen::Vector<double, N> amplitude;
+            Eigen::Vector<double, EIGEN_SIZE<N>> amplitude;
 
             /** @brief Frequencies of the wave components (Hz). */
-            const Eigen::Vector<double, N> frequency;
+            const Eigen::Vector<double, EIGEN_SIZE<N>> frequency;
 
             /** @brief Phase lags of the wave components (radian). */
-            const Eigen::Vector<double, N> phase_lag;
+            Eigen::Vector<double, EIGEN_SIZE<N>> phase_lag;
 
             /** @brief Directions of wave propagation (radian, clockwise from geographic north). */
-            const Eigen::Vector<double, N> heading;
+            Eigen::Vector<double, EIGEN_SIZE<N>> heading;
 
             // Calculated variables
             // --------------------
             /** @brief Wave heights, 2 × amplitude (m). */
-            const Eigen::Vector<double, N> height;
+            Eigen::Vector<double, EIGEN_SIZE<N>> height;
 
             /** @brief Time periods, inverse of frequency (sec). */
-            const Eigen::Vector<double, N> time_period;
+            const Eigen::Vector<double, EIGEN_SIZE<N>> time_period;
 
             /** @brief Wavelengths computed via linear wave theory (m). */
-            const Eigen::Vector<double, N> wave_length;
+            const Eigen::Vector<double, EIGEN_SIZE<N>> wave_length;
 
             /** @brief Wave numbers, 2π ÷ wavelength. */
-            const Eigen::Vector<double, N> wave_number;
+            const Eigen::Vector<double, EIGEN_SIZE<N>> wave_number;
+
+            /** @brief Cosines of the directions of wave propagation (counter-clockwise from geographic east). */
+            Eigen::Vector<double, EIGEN_SIZE<N>> heading_cos;
+
+            /** @brief Sines of the directions of wave propagation (counter-clockwise from geographic east). */
+            Eigen::Vector<double, EIGEN_SIZE<N>> heading_sin;
+
+
+        private:
+
+            /**
+             * @brief Returns the number of wave components, checking that the parameter vectors agree in length.
+             */
+            static size_t get_count(const Eigen::Vector<double, EIGEN_SIZE<N>>& amplitude, 
+                                    const Eigen::Vector<double, EIGEN_SIZE<N>>& frequency, 
+                                    const Eigen::Vector<double, EIGEN_SIZE<N>>& phase_lag, 
+                                    const Eigen::Vector<double, EIGEN_SIZE<N>>& heading) {
+                if(frequency.size() != amplitude.size() or phase_lag.size() != amplitude.size() or heading.size() != amplitude.size()) {
+                    throw std::invalid_argument("Wave parameter vectors must have the same length.");
+                }
+                return amplitude.size();
+            }
+
+
+            /**
+             * @brief Pads a parameter vector with zeros to get_padded_count() entries for N = DYNAMIC.
+             */
+            static Eigen::Vector<double, EIGEN_SIZE<N>> pad(const Eigen::Vector<double, EIGEN_SIZE<N>>& parameter) {
+                if constexpr (N == DYNAMIC) {
+                    Eigen::VectorXd padded = Eigen::VectorXd::Zero(get_padded_count(parameter.size()));
+                    padded.head(parameter.size()) = parameter;
+                    return padded;
+                } else {
+                    return parameter;
+                }
+            }
+    };
+
+
+
+    /**
+     * @brief Incremental time stepping of a collection of regular waves at a fixed location.
+     * 
+     * The phase of each component at a fixed location changes by -2π × frequency × time_step_size
+     * every step, so the wave can be held as a unit complex phasor z = exp(i × phase) and advanced by
+     * multiplying with the constant rotation exp(-i × 2π × frequency × time_step_size). The elevation
+     * and the pressure are then the real part of z scaled by the amplitude, which costs a few 
+     * multiply-adds per component instead of a cosine.
+     * 
+     * This suits sampling points that do not move horizontally, such as a wave probe, long sea 
+     * state records, or a vehicle held in place. Moving the location re-evaluates the phasors once
+     * (see set_location()).
+     * 
+     * Rounding in the repeated products makes the magnitude of the phasors drift by about one unit
+     * in the last place per step. The phasors are rescaled to unit magnitude every 
+     * renormalisation_interval steps. The phase error grows by the same order per step, i.e. about 
+     * 1e-10 radian after a million steps. For that reason the phasors are held in double precision 
+     * whatever the scalar type of the regular waves.
+     * 
+     * @tparam N Number of regular component waves, or DYNAMIC.
+     * @tparam Trig Trigonometry policy of the regular waves.
+     * @tparam Real Scalar type of the regular waves.
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double>
+    class WavePhasor {
+
+        public:
+
+            /**
+             * @brief Constructs the phasors of a collection of regular waves at a fixed location.
+             * 
+             * @param waves Regular waves to be evaluated. The reference must outlive the phasor.
+             * @param location 3D coordinates (in meters) where the waves are evaluated.
+             * @param time Start time in seconds since the start of the simulation (must be non-negative).
+             * @param time_step_size Time step size (in milliseconds, must be positive).
+             * @param renormalisation_interval Number of steps between renormalisations of the phasors.
+             * 
+             * @throws std::invalid_argument if time is negative, time_step_size is not positive or 
+             *         renormalisation_interval is zero.
+             */
+            WavePhasor(const RegularWave<N, Trig, Real>& waves, 
+                       const Geometry::Coordinates3D& location, 
+                       const double time, 
+                       const double time_step_size, 
+                       const size_t renormalisation_interval = 1000) :
+            waves {waves},
+            start_time {time},
+            time_step_size {time_step_size},
+            renormalisation_interval {renormalisation_interval},
+            rotation {(std::complex<double>(0.0, -2.0 * M_PI * time_step_size/1000.0) * waves.frequency.array().template cast<std::complex<double>>()).exp()} {
+                if(time < 0.0) {
+                    throw std::invalid_argument("Time cannot be negative.");
+                }
+                if(time_step_size <= 0.0) {
+                    throw std::invalid_argument("Time step size must be positive.");
+                }
+                if(renormalisation_interval == 0) {
+                    throw std::invalid_argument("Renormalisation interval must be positive.");
+                }
+                set_location(location);
+            }
+
+
+            /**
+             * @brief Advances the phasors by one time step.
+             */
+            void step() {
+                phasor *= rotation;
+                ++count_steps;
+                if(count_steps % renormalisation_interval == 0) {
+                    phasor /= phasor.abs();
+                }
+            }
+
+
+            /**
+             * @brief Moves the sampling point, keeping the current time.
+             * 
+             * Re-evaluates the phase of every component, which costs one sine and cosine per component.
+             * 
+             * @param location 3D coordinates (in meters) where the waves are evaluated.
+             */
+            void set_location(const Geometry::Coordinates3D& location) {
+                this->location = location;
+                const Eigen::Vector<double, EIGEN_SIZE<N>> phase = waves.get_phase(location, get_time());
+                phasor.resize(phase.size());
+                phasor.real() = Trig::cos(phase.array());
+                phasor.imag() = Trig::sin(phase.array());
+            }
+
+
+            /**
+             * @brief Returns the location (in meters) where the waves are evaluated.
+             */
+            Geometry::Coordinates3D get_location() const {
+                return location;
+            }
+
+
+            /**
+             * @brief Returns the time (in seconds) of the current step.
+             */
+            double get_time() const {
+                return start_time + count_steps * time_step_size/1000.0;
+            }
+
+
+            /**
+             * @brief Returns the time step size (in milliseconds).
+             */
+            double get_time_step_size() const {
+                return time_step_size;
+            }
+
+
+            /**
+             * @brief Computes the wave elevation at the current step.
+             * 
+             * @return Eigen::Vector<double, EIGEN_SIZE<N>> Wave elevation in meters of each component.
+             */
+            Eigen::Vector<double, EIGEN_SIZE<N>> get_elevation() const {
+                return waves.amplitude.array() * phasor.real();
+            }
+
+
+            /**
+             * @brief Computes the wave pressure amplitude at the current step.
+             * 
+             * @return Eigen::Vector<double, EIGEN_SIZE<N>> Wave pressure amplitude in N/m² of each component.
+             */
+            Eigen::Vector<double, EIGEN_SIZE<N>> get_wave_pressure() const {
+                return -Constants::SEA_WATER_DENSITY * Constants::G * waves.amplitude.array() * phasor.real();
+            }
+
+
+        private:
+
+            /** @brief Regular waves being evaluated. */
+            const RegularWave<N, Trig, Real>& waves;
+
+            /** @brief Time (in seconds) of the first step. */
+            const double start_time;
+
+            /** @brief Time step size (in milliseconds). */
+            const double time_step_size;
+
+            /** @brief Number of steps between renormalisations of the phasors. */
+            const size_t renormalisation_interval;
+
+            /** @brief Rotation applied to each phasor per step, exp(-i × 2π × frequency × time_step_size). */
+            const Eigen::Array<std::complex<double>, EIGEN_SIZE<N>, 1> rotation;
+
+            /** @brief Location where the waves are evaluated. */
+            Geometry::Coordinates3D location;
+
+            /** @brief Phasor exp(i × phase) of each component at the current step. */
+            Eigen::Array<std::complex<double>, EIGEN_SIZE<N>, 1> phasor;
+
+            /** @brief Number of steps taken since the start time. */
+            size_t count_steps {0};
     };
 
 }
\ No newline at end of file
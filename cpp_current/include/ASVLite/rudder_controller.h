@@ -97,6 +97,13 @@ namespace ASVLite {
                                         const Geometry::Coordinates3D& asv_attitude, 
                                         const Geometry::Coordinates3D& waypoint) const;
             
+            /**
+             * @brief Returns the sea states and headings the controller is tuned over.
+             * 
+             * @return std::vector<std::pair<double, double>> Pairs of significant wave height (in meters) and target heading (in radians).
+             */
+            static std::vector<std::pair<double, double>> get_tuning_conditions();
+            
             /**
              * @brief Simulates the wave glider's behavior based on wave height, heading, and PID gains.
              * 
@@ -108,9 +115,10 @@ namespace ASVLite {
              * @param P Proportional gain.
              * @param I Integral gain.
              * @param D Derivative gain.
+             * @param count_component_waves Number of regular component waves used to model the sea surface.
              * @return double A performance metric based on the simulation.
              */
-            double simulate_wave_glider(const double significant_wave_ht, const double asv_heading, const double P, const double I, const double D) const;
+            double simulate_wave_glider(const double significant_wave_ht, const double asv_heading, const double P, const double I, const double D, const size_t count_component_waves = 15) const;
         
         private:
             /** @brief Specification of the ASV (geometry and other parameters). */
@@ -118,6 +126,9 @@ namespace ASVLite {
             
             /** @brief Maximum allowable rudder angle (30 degrees). */
             constexpr static double max_rudder_angle = M_PI / 6.0;
+
+            /** @brief Number of regular component waves in the sea states used for tuning the controller. */
+            constexpr static size_t count_tuning_component_waves = 15;
             
             /** @brief Vector of control gains (P, I, D). */
             Eigen::Vector3d K;
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <Eigen/Dense>
+#include "geometry.h"
+#include "sea_surface.h"
+
+
+namespace ASVLite {
+
+    /**
+     * @brief Sea state at an instant of a SeaStateTimeline.
+     */
+    struct SeaStateKeyframe {
+        /** @brief Time in seconds since the start of the simulation. */
+        double time;
+
+        /** @brief Significant wave height (in meters, must be positive). */
+        double significant_wave_height;
+
+        /** @brief Predominant wave heading in radians, measured clockwise from geographic north. */
+        double predominant_wave_heading;
+
+        /** @brief Peak wave period (in seconds). Zero to use the period of a fully developed sea, as SeaSurface does. */
+        double peak_wave_period = 0.0;
+    };
+
+
+    /**
+     * @brief A sea surface whose sea state varies in time through a series of keyframes.
+     *
+     * The timeline owns one SeaSurface and updates its component waves in place as time advances, so a
+     * vehicle can run a long hindcast replay against one sea surface with no rebuilds, no jumps in
+     * the elevation and no allocation.
+     *
+     * All keyframes share the component frequencies of the sea surface, in bands of equal width in log frequency
+     * (see BandSpacing::LOGARITHMIC) over a frequency range that covers the spectra of every keyframe, so each
+     * keyframe is resolved alike whether the sea builds or decays. For each keyframe the amplitude of each
+     * component is computed from the Bretschneider spectrum for its significant wave height and peak period,
+     * and the component headings are those of SeaSurface, rotated to its predominant heading. Between two
+     * keyframes the component energies (amplitude²) are interpolated linearly and the predominant heading
+     * along the shorter arc. Since the frequencies are fixed, the elevation is continuous in time.
+     *
+     * Rotating the headings moves the phase of a component in proportion to the distance from the origin.
+     * The phase lags are adjusted so that the phases at a reference location do not move, which keeps
+     * the elevation smooth for vehicles operating around that location.
+     *
+     * Call set_time() before each step of the vehicles that use get_sea_surface(). Phasors (see
+     * SeaSurface::get_phasor()) of the sea surface do not follow the updates.
+     *
+     * @tparam N Number of regular component waves, or DYNAMIC (see SeaSurface).
+     * @tparam Trig Trigonometry policy of the sea surface.
+     * @tparam Real Scalar type of the sea surface.
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double>
+    class SeaStateTimeline {
+
+        public:
+
+            /**
+             * @brief Constructs a timeline and sets the sea surface to the sea state at time zero.
+             *
+             * @param keyframes Sea states in ascending order of time (at least one).
+             * @param random_number_seed Seed for the random number generator used in wave spectrum generation.
+             * @param count_component_waves Number of regular component waves. Required for N = DYNAMIC, and must equal N otherwise.
+             * @param reference_location Location (in meters) about which the component waves rotate with the predominant heading.
+             *
+             * @throws std::invalid_argument if there are no keyframes, the times are not strictly increasing, a significant
+             *         wave height is not positive or a peak period is negative, or for the reasons the SeaSurface constructor 
+             *         throws for the covering frequency range.
+             */
+            SeaStateTimeline(const std::vector<SeaStateKeyframe>& keyframes,
+                             const int random_number_seed,
+                             const size_t count_component_waves = N,
+                             const Geometry::Coordinates3D& reference_location = {0.0, 0.0, 0.0}) :
+            keyframes {validate(keyframes)},
+            reference_location {reference_location},
+            sea_surface {keyframes.front().significant_wave_height,
+                         keyframes.front().predominant_wave_heading,
+                         random_number_seed,
+                         calculate_spectral_range(),
+                         count_component_waves},
+            amplitudes(count_component_waves, keyframes.size()),
+            relative_headings(count_component_waves),
+            base_phase_lag(count_component_waves),
+            amplitude(count_component_waves),
+            heading(count_component_waves),
+            phase_lag(count_component_waves) {
+                const RegularWave<N, Trig, Real>& waves = sea_surface.component_waves;
+                const auto [frequencies, band_sizes] = sea_surface.calculate_frequency_bands();
+                // Energy of each component for each keyframe.
+                for(size_t j = 0; j < keyframes.size(); ++j) {
+                    for(size_t i = 0; i < count_component_waves; ++i) {
+                        amplitudes(i, j) = std::sqrt(2.0 * get_spectral_density(frequencies(i), keyframes[j]) * band_sizes(i));
+                    }
+                }
+                // Headings relative to the predominant heading, and the phase lags of the waves with the phases
+                // at the reference location taken out (counter-clockwise from geographic east).
+                for(size_t i = 0; i < count_component_waves; ++i) {
+                    relative_headings(i) = Geometry::normalise_angle_PI(waves.heading(i) - sea_surface.predominant_wave_heading);
+                    base_phase_lag(i) = waves.phase_lag(i) + waves.wave_number(i) * (reference_location.keys.x * waves.heading_cos(i) +
+                                                                                     reference_location.keys.y * waves.heading_sin(i));
+                }
+                set_time(0.0);
+            }
+
+
+            /**
+             * @brief Sets the sea surface to the sea state at a given time.
+             *
+             * Before the first keyframe the sea state is that of the first keyframe, and after the last keyframe
+             * that of the last. Does not allocate.
+             *
+             * @param time Time in seconds since the start of the simulation (must be non-negative).
+             *
+             * @throws std::invalid_argument if time is negative.
+             */
+            void set_time(const double time) {
+                if(time < 0.0) {
+                    throw std::invalid_argument("Time cannot be negative.");
+                }
+                this->time = time;
+                // Keyframes on either side of the time, and the weight of the later one.
+                const auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+                                                   [](const double t, const SeaStateKeyframe& keyframe) { return t < keyframe.time; });
+                const size_t j_1 = std::min<size_t>(next - keyframes.begin(), keyframes.size() - 1);
+                const size_t j_0 = (next == keyframes.begin()) ? 0 : (next - keyframes.begin()) - 1;
+                const double w = (j_0 == j_1) ? 0.0 : (time - keyframes[j_0].time) / (keyframes[j_1].time - keyframes[j_0].time);
+                // Cross-fade the component energies, and rotate the headings to the interpolated predominant heading.
+                amplitude = ((1.0 - w) * amplitudes.col(j_0).array().square() + w * amplitudes.col(j_1).array().square()).sqrt();
+                const double heading_0 = keyframes[j_0].predominant_wave_heading;
+                const double heading_1 = keyframes[j_1].predominant_wave_heading;
+                const double predominant_wave_heading = Geometry::normalise_angle_PI(heading_0 + w * Geometry::normalise_angle_PI(heading_1 - heading_0));
+                const double predominant_heading_east = Geometry::switch_angle_frame(predominant_wave_heading); // Counter-clockwise from geographic east.
+                const RegularWave<N, Trig, Real>& waves = sea_surface.component_waves;
+                for(Eigen::Index i = 0; i < heading.size(); ++i) {
+                    const double heading_east = predominant_heading_east + relative_headings(i);
+                    heading(i) = Geometry::switch_angle_frame(heading_east);
+                    phase_lag(i) = base_phase_lag(i) - waves.wave_number(i) * (reference_location.keys.x * std::cos(heading_east) +
+                                                                               reference_location.keys.y * std::sin(heading_east));
+                }
+                sea_surface.component_waves.set_sea_state(amplitude, phase_lag, heading);
+                sea_surface.significant_wave_height = std::sqrt((1.0 - w) * std::pow(keyframes[j_0].significant_wave_height, 2) +
+                                                                      w  * std::pow(keyframes[j_1].significant_wave_height, 2));
+                sea_surface.predominant_wave_heading = predominant_wave_heading;
+            }
+
+
+            /**
+             * @brief Returns the time of the sea state.
+             *
+             * @return double Time in seconds since the start of the simulation.
+             */
+            double get_time() const {
+                return time;
+            }
+
+
+            /**
+             * @brief Returns the significant wave height of the sea state at the current time.
+             *
+             * @return double Significant wave height in meters, interpolated as the square root of the energy.
+             */
+            double get_significant_wave_height() const {
+                return sea_surface.significant_wave_height;
+            }
+
+
+            /**
+             * @brief Returns the predominant wave heading of the sea state at the current time.
+             *
+             * @return double Predominant wave heading in radians, measured clockwise from geographic north.
+             */
+            double get_predominant_wave_heading() const {
+                return sea_surface.predominant_wave_heading;
+            }
+
+
+            /**
+             * @brief Returns the sea surface, updated in place by set_time().
+             *
+             * The significant wave height and the predominant wave heading of the sea surface follow the time. The 
+             * fields of the spectrum (e.g. peak_spectral_frequency and spectral_variance) stay those computed at construction
+             * for the frequency range that covers every keyframe.
+             *
+             * @return const SeaSurface<N, Trig, Real>* The sea surface. It is owned by the timeline and must not outlive it.
+             */
+            const SeaSurface<N, Trig, Real>* get_sea_surface() const {
+                return &sea_surface;
+            }
+
+
+            /** @brief Sea states in ascending order of time. */
+            const std::vector<SeaStateKeyframe> keyframes;
+
+            /** @brief Location (in meters) about which the component waves rotate with the predominant heading. */
+            const Geometry::Coordinates3D reference_location;
+
+
+        private:
+
+            /**
+             * @brief Checks that the keyframes are usable.
+             */
+            static const std::vector<SeaStateKeyframe>& validate(const std::vector<SeaStateKeyframe>& keyframes) {
+                if(keyframes.empty()) {
+                    throw std::invalid_argument("Sea state timeline requires at least one keyframe.");
+                }
+                for(size_t j = 0; j < keyframes.size(); ++j) {
+                    if(keyframes[j].significant_wave_height <= 0.0) {
+                        throw std::invalid_argument("Significant wave height must be positive.");
+                    }
+                    if(keyframes[j].peak_wave_period < 0.0) {
+                        throw std::invalid_argument("Peak wave period cannot be negative.");
+                    }
+                    if(j > 0 and keyframes[j].time <= keyframes[j-1].time) {
+                        throw std::invalid_argument("Keyframe times must be strictly increasing.");
+                    }
+                }
+                return keyframes;
+            }
+
+
+            /**
+             * @brief Returns the peak spectral frequency of a keyframe (in Hz).
+             */
+            static double get_peak_frequency(const SeaStateKeyframe& keyframe) {
+                if(keyframe.peak_wave_period > 0.0) {
+                    return 1.0 / keyframe.peak_wave_period;
+                }
+                return SeaSurface<N, Trig, Real>::get_peak_spectral_frequency(keyframe.significant_wave_height);
+            }
+
+
+            /**
+             * @brief Bretschneider spectral density of a keyframe at a given frequency (in m²/Hz).
+             *
+             * For a keyframe with a peak period, the two parameter form S(f) = (5/16) Hs² f_p⁴ f⁻⁵ exp(-(5/4) (f_p/f)⁴).
+             * Otherwise the spectrum of a fully developed sea, as SeaSurface::get_spectral_density().
+             *
+             * @ref Proceedings of the 23rd ITTC - Vol II, Table A.2.
+             */
+            static double get_spectral_density(const double frequency, const SeaStateKeyframe& keyframe) {
+                if(keyframe.peak_wave_period > 0.0) {
+                    const double f_p4 = pow(1.0 / keyframe.peak_wave_period, 4.0);
+                    const double H_s = keyframe.significant_wave_height;
+                    return (5.0/16.0) * H_s*H_s * f_p4 / pow(frequency, 5.0) * exp(-1.25 * f_p4 / pow(frequency, 4.0));
+                }
+                return SeaSurface<N, Trig, Real>::get_spectral_density(frequency, keyframe.significant_wave_height);
+            }
+
+
+            /**
+             * @brief Returns a frequency range that covers the spectrum of every keyframe, divided into logarithmic bands.
+             *
+             * The range of each keyframe is [0.652, 5.946] × its peak frequency, as for SeaSurface.
+             */
+            SpectralRange calculate_spectral_range() const {
+                SpectralRange range {0.652 * get_peak_frequency(keyframes.front()),
+                                     5.946 * get_peak_frequency(keyframes.front()),
+                                     BandSpacing::LOGARITHMIC};
+                for(const SeaStateKeyframe& keyframe : keyframes) {
+                    range.min_frequency = std::min(range.min_frequency, 0.652 * get_peak_frequency(keyframe));
+                    range.max_frequency = std::max(range.max_frequency, 5.946 * get_peak_frequency(keyframe));
+                }
+                return range;
+            }
+
+
+            /** @brief Sea surface updated in place. */
+            SeaSurface<N, Trig, Real> sea_surface;
+
+            /** @brief Amplitude (m) of each component (row) for each keyframe (column). */
+            Eigen::MatrixXd amplitudes;
+
+            /** @brief Heading of each component relative to the predominant heading (radian). */
+            Eigen::VectorXd relative_headings;
+
+            /** @brief Phase lag of each component, less its phase at the reference location (radian). */
+            Eigen::VectorXd base_phase_lag;
+
+            /** @brief Amplitudes at the current time (m). */
+            Eigen::VectorXd amplitude;
+
+            /** @brief Headings at the current time (radian, clockwise from geographic north). */
+            Eigen::VectorXd heading;
+
+            /** @brief Phase lags at the current time (radian). */
+            Eigen::VectorXd phase_lag;
+
+            /** @brief Time of the sea state (sec). */
+            double time {0.0};
+    };
+
+}
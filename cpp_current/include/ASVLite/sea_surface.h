@@ -2,21 +2,77 @@
 
 #include <cmath>
 #include <stdexcept>
+#include <string>
 #include <thread>
-#include <random>
+#include <memory>
+#include <exception>
+#include <atomic>
+#include <vector>
+#include <numeric>
+#include <algorithm>
 #include "geometry.h"
 #include "regular_wave.h"
+#include "random.h"
 #include "ASVLite/constants.h"
 
 
 namespace ASVLite {
 
+    /**
+     * @brief Sea surface elevation at a point, with its rate of change and slope, from one pass over the component waves.
+     */
+    struct SurfaceKinematics {
+        /** @brief Sea surface elevation (in meters). */
+        double elevation;
+
+        /** @brief Vertical velocity of the sea surface, the rate of change of the elevation (in m/s). */
+        double vertical_velocity;
+
+        /** @brief Slope of the sea surface along the x-axis (east), rate of change of the elevation with x. */
+        double slope_x;
+
+        /** @brief Slope of the sea surface along the y-axis (north), rate of change of the elevation with y. */
+        double slope_y;
+    };
+
+
+    /**
+     * @brief Division of a spectral frequency range into the bands of the component waves of a sea surface.
+     */
+    enum class BandSpacing {
+        /** @brief One band around the peak spectral frequency, with equal bands below and above it. */
+        PEAK,
+
+        /** @brief Bands of equal width in log frequency, for a range that covers the spectra of several sea states. */
+        LOGARITHMIC
+    };
+
+
+    /**
+     * @brief Range of frequencies divided into the bands of the component waves of a sea surface.
+     */
+    struct SpectralRange {
+        /** @brief Lower limit of the lowest band (in Hz). */
+        double min_frequency;
+
+        /** @brief Upper limit of the highest band (in Hz). */
+        double max_frequency;
+
+        /** @brief Division of the range into bands. */
+        BandSpacing band_spacing = BandSpacing::PEAK;
+    };
+
+
     /**
      * @brief Models an irregular sea surface as a superposition of N regular component waves.
      * 
-     * @tparam N Number of regular component waves in the wave spectrum. Must be an odd number >= 3.
+     * @tparam N Number of regular component waves in the wave spectrum. Must be an odd number >= 9, or DYNAMIC
+     *         to set the number at run time.
+     * @tparam Trig Trigonometry policy used to evaluate the waves (see Trigonometry::Exact and Trigonometry::Fast).
+     * @tparam Real Scalar type in which the component waves are evaluated and summed. Use float to halve
+     *         the width of the per-component arithmetic; locations, time and the returned elevation stay double.
      */
-    template<size_t N>
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double>
     class SeaSurface {
 
         public:
@@ -27,17 +83,56 @@ namespace ASVLite {
              * @param significant_wave_height Significant wave height (in meters) of the irregular sea surface (must be non-negative).
              * @param predominant_wave_heading Predominant wave heading in radians, measured clockwise from geographic north.
              * @param random_number_seed Seed for the random number generator used in wave spectrum generation.
+             * @param count_component_waves Number of frequency bands the spectrum is divided into, one regular component 
+             *        wave each. Required for N = DYNAMIC, and must equal N otherwise.
+             * @param variance_tolerance Fraction of the variance of the spectrum that may be dropped by pruning the component 
+             *        waves of least energy (see calculate_wave_spectrum()). Zero keeps every component. Only for N = DYNAMIC.
+             * 
+             * @throws std::invalid_argument if count_component_waves is not an odd number greater than or equal to 9, 
+             *         or differs from a fixed N, or if variance_tolerance is not in [0, 1), or is positive for a fixed N.
+             */
+            SeaSurface(const double significant_wave_height, const double predominant_wave_heading, const int random_number_seed, 
+                       const size_t count_component_waves = N, const double variance_tolerance = 0.0) : 
+            SeaSurface(significant_wave_height, predominant_wave_heading, random_number_seed, 
+                       SpectralRange {0.652 * get_peak_spectral_frequency(significant_wave_height), 
+                                      5.946 * get_peak_spectral_frequency(significant_wave_height)}, 
+                       count_component_waves, variance_tolerance) {
+            }
+
+
+            /**
+             * @brief Constructs a sea surface model whose component waves span a given frequency range.
+             * 
+             * The default range, [0.652, 5.946] × peak spectral frequency, holds the energy of the sea state.
+             * A wider range with logarithmic band spacing lets several sea states share one set of component 
+             * frequencies (see SeaStateTimeline).
+             * 
+             * @param significant_wave_height Significant wave height (in meters) of the irregular sea surface (must be non-negative).
+             * @param predominant_wave_heading Predominant wave heading in radians, measured clockwise from geographic north.
+             * @param random_number_seed Seed for the random number generator used in wave spectrum generation.
+             * @param spectral_range Frequency range divided into the bands of the component waves (see calculate_frequency_bands()).
+             * @param count_component_waves Number of frequency bands. Required for N = DYNAMIC, and must equal N otherwise.
+             * @param variance_tolerance Fraction of the variance of the spectrum that may be dropped by pruning. Only for N = DYNAMIC.
+             * 
+             * @throws std::invalid_argument as the constructor above, or if spectral_range cannot be divided into the bands
+             *         (see calculate_frequency_bands()).
              */
-            SeaSurface(const double significant_wave_height, const double predominant_wave_heading, const int random_number_seed) : 
+            SeaSurface(const double significant_wave_height, const double predominant_wave_heading, const int random_number_seed, 
+                       const SpectralRange& spectral_range, const size_t count_component_waves = N, const double variance_tolerance = 0.0) : 
             significant_wave_height {significant_wave_height},
             predominant_wave_heading {Geometry::switch_angle_frame(predominant_wave_heading)}, // Covert angle to counter-clockwise from geographic east (x-axis). 
             random_number_seed {random_number_seed},
-            peak_spectral_frequency {calculate_peak_spectral_frequency()},
-            min_spectral_frequency {0.652 * peak_spectral_frequency},
-            max_spectral_frequency {5.946 * peak_spectral_frequency},
+            count_component_waves {count_component_waves},
+            variance_tolerance {variance_tolerance},
+            peak_spectral_frequency {get_peak_spectral_frequency(significant_wave_height)},
+            min_spectral_frequency {spectral_range.min_frequency},
+            max_spectral_frequency {spectral_range.max_frequency},
+            band_spacing {spectral_range.band_spacing},
             min_spectral_wave_heading {Geometry::normalise_angle_PI(predominant_wave_heading - M_PI/2.0)},
             max_spectral_wave_heading {Geometry::normalise_angle_PI(predominant_wave_heading + M_PI/2.0)},
-            component_waves {calculate_wave_spectrum()} {
+            spectral_variance {calculate_spectral_variance()},
+            component_waves {calculate_wave_spectrum()},
+            retained_variance_fraction {component_waves.amplitude.squaredNorm() / 2.0 / spectral_variance} {
             }
 
 
@@ -54,34 +149,247 @@ namespace ASVLite {
                 if(time < 0.0) {
                     throw std::invalid_argument("Time cannot be negative.");
                 }
-                const Eigen::Vector<double, N> component_waves_elevation = component_waves.get_elevation(location, time);
-                double elevation = component_waves_elevation.sum();
-                return elevation;
+                // Same evaluation as RegularWave::get_elevation(), summed without materialising the components.
+                return dispatch_component_count<N>(component_waves.amplitude.size(), [&]<int M>() {
+                    const size_t size = component_waves.amplitude.size();
+                    const ComponentArray<M> amplitude   (component_waves.amplitude.data(),   size);
+                    const ComponentArray<M> frequency   (component_waves.frequency.data(),   size);
+                    const ComponentArray<M> phase_lag   (component_waves.phase_lag.data(),   size);
+                    const ComponentArray<M> wave_number (component_waves.wave_number.data(), size);
+                    const ComponentArray<M> heading_cos (component_waves.heading_cos.data(), size);
+                    const ComponentArray<M> heading_sin (component_waves.heading_sin.data(), size);
+                    const Eigen::Array<double, M, 1> A = wave_number * (location.keys.x * heading_cos + location.keys.y * heading_sin);
+                    const Eigen::Array<double, M, 1> B = 2.0 * M_PI * frequency * time;
+                    const Eigen::Array<double, M, 1> phase = A - B + phase_lag;
+                    double elevation = (amplitude.template cast<Real>() * Trig::cos(Trigonometry::reduce_phase<Real>(phase))).sum();
+                    return elevation;
+                });
+            }
+
+
+            /**
+             * @brief Computes the sea surface elevation at a given location and time, with its rate of change and slope.
+             * 
+             * The derivatives are analytic, from the same phase as the elevation. With phase 
+             * P = k (x cos(h) + y sin(h)) - 2PI f t + phase_lag of each component:
+             * - elevation = sum(a cos(P))
+             * - vertical velocity = sum(2PI f a sin(P))
+             * - slope along x = -sum(k cos(h) a sin(P)), and along y = -sum(k sin(h) a sin(P))
+             * 
+             * @param location 3D coordinates (in meters) where the sea surface is evaluated.
+             * @param time Time in seconds since the start of the simulation (must be non-negative).
+             * @return SurfaceKinematics Elevation, vertical velocity and slope of the sea surface at the location and time.
+             * 
+             * @throws std::invalid_argument if time is negative.
+             */
+            SurfaceKinematics get_surface_kinematics(const Geometry::Coordinates3D& location, const double time) const {
+                if(time < 0.0) {
+                    throw std::invalid_argument("Time cannot be negative.");
+                }
+                return dispatch_component_count<N>(component_waves.amplitude.size(), [&]<int M>() {
+                    const size_t size = component_waves.amplitude.size();
+                    const ComponentArray<M> amplitude   (component_waves.amplitude.data(),   size);
+                    const ComponentArray<M> frequency   (component_waves.frequency.data(),   size);
+                    const ComponentArray<M> phase_lag   (component_waves.phase_lag.data(),   size);
+                    const ComponentArray<M> wave_number (component_waves.wave_number.data(), size);
+                    const ComponentArray<M> heading_cos (component_waves.heading_cos.data(), size);
+                    const ComponentArray<M> heading_sin (component_waves.heading_sin.data(), size);
+                    const Eigen::Array<double, M, 1> A = wave_number * (location.keys.x * heading_cos + location.keys.y * heading_sin);
+                    const Eigen::Array<double, M, 1> B = 2.0 * M_PI * frequency * time;
+                    const Eigen::Array<Real, M, 1> phase = Trigonometry::reduce_phase<Real>(A - B + phase_lag);
+                    const Eigen::Array<Real, M, 1> amplitude_real = amplitude.template cast<Real>();
+                    const Eigen::Array<Real, M, 1> amplitude_sin = amplitude_real * Trig::sin(phase);
+                    SurfaceKinematics kinematics;
+                    kinematics.elevation         =  (amplitude_real * Trig::cos(phase)).sum();
+                    kinematics.vertical_velocity =  (amplitude_sin * (2.0 * M_PI * frequency).template cast<Real>()).sum();
+                    kinematics.slope_x           = -(amplitude_sin * (wave_number * heading_cos).template cast<Real>()).sum();
+                    kinematics.slope_y           = -(amplitude_sin * (wave_number * heading_sin).template cast<Real>()).sum();
+                    return kinematics;
+                });
+            }
+
+
+            /**
+             * @brief Creates a phasor for incremental evaluation of the sea surface at a fixed location.
+             * 
+             * @param location 3D coordinates (in meters) where the sea surface is evaluated.
+             * @param time Start time in seconds since the start of the simulation (must be non-negative).
+             * @param time_step_size Time step size (in milliseconds).
+             * @return WavePhasor<N, Trig, Real> Phasor of the component waves. It refers to this sea surface and must not outlive it.
+             * 
+             * @throws std::invalid_argument if time is negative or time_step_size is not positive.
+             */
+            WavePhasor<N, Trig, Real> get_phasor(const Geometry::Coordinates3D& location, const double time, const double time_step_size) const {
+                return WavePhasor<N, Trig, Real> {component_waves, location, time, time_step_size};
+            }
+
+
+            /**
+             * @brief Computes the sea surface elevation at the current step of a phasor.
+             * 
+             * @param phasor Phasor created by get_phasor() for this sea surface.
+             * @return double Sea surface elevation in meters at the location and time of the phasor.
+             */
+            double get_elevation(const WavePhasor<N, Trig, Real>& phasor) const {
+                return phasor.get_elevation().sum();
+            }
+
+
+            /**
+             * @brief Calculates the peak spectral frequency of a sea state.
+             * 
+             * @param significant_wave_height Significant wave height (in meters).
+             * @return double Peak spectral frequency in Hz.
+             */
+            static double get_peak_spectral_frequency(const double significant_wave_height) {
+                constexpr double alpha = 0.0081;
+                const double B = 4.0 * alpha * Constants::G*Constants::G / (pow(2.0*M_PI, 4.0) * significant_wave_height*significant_wave_height);
+                const double f_p = 0.946 * pow(B, 0.25);
+                return f_p;
+            }
+
+
+            /**
+             * @brief Computes the Bretschneider spectral density of a fully developed sea at a given frequency.
+             * 
+             * S(f) = (A/f^5) exp(-B/f^4), with A = alpha g^2 (2 PI)^-4, alpha = 0.0081, and B chosen so 
+             * that the significant wave height of the spectrum equals significant_wave_height.
+             * 
+             * @param frequency Wave frequency in Hz (must be positive).
+             * @param significant_wave_height Significant wave height (in meters).
+             * @return double Spectral density in m²/Hz.
+             * 
+             * @ref Proceedings of the 23rd ITTC - Vol II, Table A.2, A.3.
+             */
+            static double get_spectral_density(const double frequency, const double significant_wave_height) {
+                // Bretschneider spectrum
+                // Ref: Proceedings of the 23rd ITTC - Vol II, Table A.2, A.3.
+                // S(f) = (A/f^5) exp(-B/f^4)
+                // A = alpha g^2 (2 PI)^-4
+                // B = beta (2PI U/g)^-4
+                // alpha = 0.0081
+                // beta = 0.74
+                // f_p = 0.946 B^(1/4)
+                // U = wind speed in m/s
+                constexpr double alpha = 0.0081;
+                const double A = alpha * Constants::G*Constants::G * pow(2.0*M_PI, -4.0);
+                const double B = 4.0 * alpha * Constants::G*Constants::G / (pow(2.0*M_PI, 4.0) * significant_wave_height*significant_wave_height);
+                const double S = (A / pow(frequency, 5.0)) * exp(-B / pow(frequency, 4.0));
+                return S;
+            }
+
+
+            /**
+             * @brief Computes the Bretschneider spectral density of the sea state at a given frequency.
+             * 
+             * @param frequency Wave frequency in Hz (must be positive).
+             * @return double Spectral density in m²/Hz.
+             */
+            double get_spectral_density(const double frequency) const {
+                return get_spectral_density(frequency, significant_wave_height);
+            }
+
+
+            /**
+             * @brief Divides the spectral frequency range into one band per component wave.
+             * 
+             * With BandSpacing::PEAK, the band around the peak spectral frequency is (max - min)/count wide, and the 
+             * remaining range below and above it is divided into (count-1)/2 equal bands each. With BandSpacing::LOGARITHMIC,
+             * the range is divided into bands of equal width in log frequency, so spectra with different peaks are resolved 
+             * alike. The component frequency is the centre of its band (the geometric centre for logarithmic spacing), and 
+             * the components are in ascending order of frequency.
+             * 
+             * @return std::pair<Eigen::VectorXd, Eigen::VectorXd> Frequency (in Hz) and band width (in Hz) of each component.
+             * 
+             * @throws std::invalid_argument if the number of component waves is not an odd number greater than or equal to 9,
+             *         or differs from a fixed N, or if the spectral frequency range is empty, or, for 
+             *         BandSpacing::PEAK, leaves no room for the bands below the band around the peak spectral frequency.
+             */
+            std::pair<Eigen::VectorXd, Eigen::VectorXd> calculate_frequency_bands() const {
+                if(N != DYNAMIC and count_component_waves != N) {
+                    throw std::invalid_argument("Number of component waves must equal N.");
+                }
+                if(count_component_waves % 2 == 0 or count_component_waves < 9) {
+                    throw std::invalid_argument("Number of component waves must be an odd number greater than or equal to 9.");
+                }
+                const std::string range = "[" + std::to_string(min_spectral_frequency) + ", " + std::to_string(max_spectral_frequency) + "] Hz";
+                if(not (0.0 < min_spectral_frequency and min_spectral_frequency < max_spectral_frequency)) {
+                    throw std::invalid_argument("Spectral frequency range " + range + " must be positive and non-empty.");
+                }
+                Eigen::VectorXd frequencies(count_component_waves);
+                Eigen::VectorXd band_sizes(count_component_waves);
+                if(band_spacing == BandSpacing::LOGARITHMIC) {
+                    const double ratio = std::pow(max_spectral_frequency / min_spectral_frequency, 1.0 / count_component_waves);
+                    for(size_t i = 0; i < count_component_waves; ++i) {
+                        const double band_low_limit = min_spectral_frequency * std::pow(ratio, static_cast<double>(i));
+                        frequencies(i) = band_low_limit * std::sqrt(ratio);
+                        band_sizes(i) = band_low_limit * (ratio - 1.0);
+                    }
+                    return {frequencies, band_sizes};
+                }
+                if(not (min_spectral_frequency < peak_spectral_frequency and peak_spectral_frequency < max_spectral_frequency)) {
+                    throw std::invalid_argument("Spectral frequency range " + range + " must contain the peak spectral frequency " + 
+                                                std::to_string(peak_spectral_frequency) + " Hz.");
+                }
+                const size_t half_count = (count_component_waves-1)/2; // Half of the component wave count
+                const double frequency_band_size_peak = (max_spectral_frequency - min_spectral_frequency) / count_component_waves;
+                const double peak_freq_band_low_limit = peak_spectral_frequency - frequency_band_size_peak/2;
+                const double peak_freq_band_upp_limit = peak_spectral_frequency + frequency_band_size_peak/2;
+                const double frequency_band_size_min_to_peak = (peak_freq_band_low_limit  - min_spectral_frequency) / half_count;
+                const double frequency_band_size_peak_to_max = (max_spectral_frequency - peak_freq_band_upp_limit) / half_count;
+                if(frequency_band_size_min_to_peak <= 0.0) {
+                    // The band around the peak is wider than the spectrum below the peak, which leaves no room for the lower components.
+                    throw std::invalid_argument("Spectral frequency range " + range + " leaves no room below the band around the peak spectral frequency " + 
+                                                std::to_string(peak_spectral_frequency) + " Hz. Use BandSpacing::LOGARITHMIC for a range much wider than the spectrum.");
+                }
+                // Min to peak freq
+                for(size_t i = 0; i < half_count; ++i) {
+                    frequencies(i) = min_spectral_frequency + (i * frequency_band_size_min_to_peak) + frequency_band_size_min_to_peak/2.0;
+                    band_sizes(i) = frequency_band_size_min_to_peak;
+                }
+                // Peak
+                frequencies(half_count) = peak_spectral_frequency;
+                band_sizes(half_count) = frequency_band_size_peak;
+                // Peak to max freq
+                for(size_t i = 0; i < half_count; ++i) {
+                    frequencies(half_count+1+i) = peak_freq_band_upp_limit + (i * frequency_band_size_peak_to_max) + frequency_band_size_peak_to_max/2.0;
+                    band_sizes(half_count+1+i) = frequency_band_size_peak_to_max;
+                }
+                return {frequencies, band_sizes};
             }
 
 
             /**
              * @brief Computes the mean wavenumber for the sea state.
              * 
-             * @return double Mean wavenumber computed as the average of all component wave numbers.
+             * @return double Mean wavenumber computed as the average of the component wave numbers over the 
+             *         count_component_waves frequency bands, with pruned components counted as zero, as for the wave force.
              */
             double get_mean_wavenumber() const {
-                double mean_wavenumber = component_waves.wave_number.sum()/N;
+                double mean_wavenumber = component_waves.wave_number.sum()/count_component_waves;
                 return mean_wavenumber;
             }
 
 
             // Input variables
             // ---------------
-            /** @brief Significant wave height of the sea state (in meters). */
-            const double significant_wave_height;
+            /** @brief Significant wave height of the sea state (in meters). Updated with the component waves by a 
+             *         SeaStateTimeline that owns the sea surface. */
+            double significant_wave_height;
 
-            /** @brief Predominant wave heading in radians, measured clockwise from geographic north. */
-            const double predominant_wave_heading;
+            /** @brief Predominant wave heading in radians, measured clockwise from geographic north. Updated with the 
+             *         component waves by a SeaStateTimeline that owns the sea surface. */
+            double predominant_wave_heading;
 
             /** @brief Seed for the random number generator used in wave component generation. */
             const long random_number_seed;
 
+            /** @brief Number of frequency bands in the wave spectrum. Equals component_waves.count unless components were pruned. */
+            const size_t count_component_waves;
+
+            /** @brief Fraction of the variance of the spectrum that may be dropped by pruning component waves. */
+            const double variance_tolerance;
+
             // Calculated variables
             // --------------------
             /** @brief Peak spectral frequency of the wave energy distribution (in Hz). */
@@ -93,120 +401,204 @@ namespace ASVLite {
             /** @brief Maximum spectral frequency considered in the wave spectrum (in Hz). */
             const double max_spectral_frequency;
 
+            /** @brief Division of the spectral frequency range into the bands of the component waves. */
+            const BandSpacing band_spacing;
+
             /** @brief Minimum wave heading considered in the wave spectrum (in radians). */
             const double min_spectral_wave_heading;
 
             /** @brief Maximum wave heading considered in the wave spectrum (in radians). */
             const double max_spectral_wave_heading;
 
-            /** @brief Collection of N regular component waves representing the sea surface. */
-            const RegularWave<N> component_waves;
+            /** @brief Variance of the sea surface elevation over all frequency bands, before pruning (in m²). */
+            const double spectral_variance;
+
+            /** @brief Collection of N regular component waves representing the sea surface. Their amplitudes, phase lags and
+             *         headings may be updated in place by a SeaStateTimeline that owns the sea surface. */
+            RegularWave<N, Trig, Real> component_waves;
+
+            /** @brief Fraction of spectral_variance carried by component_waves, 1 unless components were pruned. */
+            const double retained_variance_fraction;
 
 
         private:
 
             /**
-             * @brief Calculates the peak spectral frequency of the sea state.
+             * @brief Calculates the variance of the sea surface elevation over all count_component_waves bands.
              * 
-             * @return double Peak spectral frequency in Hz.
+             * @return double Sum of the spectral density × band width of the bands, in m².
              */
-            double calculate_peak_spectral_frequency() const {
-                constexpr double alpha = 0.0081;
-                const double B = 4.0 * alpha * Constants::G*Constants::G / (pow(2.0*M_PI, 4.0) * significant_wave_height*significant_wave_height);
-                const double f_p = 0.946 * pow(B, 0.25);
-                return f_p;
+            double calculate_spectral_variance() const {
+                const auto [frequencies, band_sizes] = calculate_frequency_bands();
+                double variance = 0.0;
+                for(Eigen::Index i = 0; i < frequencies.size(); ++i) {
+                    variance += get_spectral_density(frequencies(i)) * band_sizes(i);
+                }
+                return variance;
             }
 
-            
+
             /**
              * @brief Generates a set of N regular wave components representing an irregular sea state.
              * 
-             * The function divides the frequency range symmetrically around the peak spectral frequency
+             * The function divides the frequency range into bands (see calculate_frequency_bands())
              * and assigns each frequency band a wave heading and amplitude using the Bretschneider spectrum.
-             * Random phase lags are sampled uniformly from [0, PI]. The result is a spectrum of waves
+             * Random phase lags are sampled uniformly from [0, PI), drawn from a counter-based generator keyed by 
+             * the seed and the component index (see Random::get_uniform()), so the spectrum depends only on the 
+             * constructor arguments and not on the thread or the order in which sea surfaces are built. The result is a spectrum of waves
              * with realistic distribution in both frequency and direction.
              * 
              * The wave spectrum is constructed as follows:
-             * - Frequencies are distributed on either sides of the peak.
+             * - Frequencies are distributed on either sides of the central band (see calculate_frequency_bands()).
              * - Wave headings are spread across +-PI/2 around the predominant wave heading.
-             * - The peak frequency aligns with the predominant wave direction, with energy diminishing symmetrically toward both sides.
+             * - The central band, at the peak frequency for BandSpacing::PEAK, aligns with the predominant wave direction, with energy diminishing symmetrically toward both sides.
              * - Amplitudes are computed from spectral density using the Bretschneider model.
              * - Phase lags are randomized.
+             * - With a positive variance_tolerance, the components are ranked by variance, amplitude²/2, and the
+             *   weakest are dropped for as long as the variance dropped stays within variance_tolerance × 
+             *   spectral_variance. The retained components keep their order of ascending frequency.
              * 
-             * @return RegularWave<N> A collection of N wave components modeling the sea surface.
+             * @return RegularWave<N, Trig, Real> A collection of N wave components modeling the sea surface.
              * 
-             * @throws std::invalid_argument if N is not an odd number greater than or equal to 3.
+             * @throws std::invalid_argument if variance_tolerance is not in [0, 1), or is positive for a fixed N.
              * 
              * @ref Proceedings of the 23rd ITTC - Vol II, Tables A.2, A.3.
              */
-            RegularWave<N> calculate_wave_spectrum() const {
-                if(N % 2 == 0 or N < 3) {
-                    throw std::invalid_argument("Number of component waves must be an odd number greater than or equal to 3.");
-                }
-                // Init random number generator
-                // Create a thread-local random engine
-                thread_local std::mt19937 rng(random_number_seed); 
-                // Define a uniform distribution
-                std::uniform_real_distribution<double> dist(0.0, M_PI);
+            RegularWave<N, Trig, Real> calculate_wave_spectrum() const {
+                if(variance_tolerance < 0.0 or variance_tolerance >= 1.0) {
+                    throw std::invalid_argument("Variance tolerance must be in the range [0, 1).");
+                }
+                if(N != DYNAMIC and variance_tolerance > 0.0) {
+                    throw std::invalid_argument("Component waves can only be pruned for N = DYNAMIC.");
+                }
                 // Compute step size for frequency and heading
-                const int half_count = (N-1)/2; // Half of the component wave count
-                const double frequency_band_size_peak = (max_spectral_frequency - min_spectral_frequency) / N;
-                const double peak_freq_band_low_limit = peak_spectral_frequency - frequency_band_size_peak/2;
-                const double peak_freq_band_upp_limit = peak_spectral_frequency + frequency_band_size_peak/2;
-                const double frequency_band_size_min_to_peak = (peak_freq_band_low_limit  - min_spectral_frequency) / half_count;
-                const double frequency_band_size_peak_to_max = (max_spectral_frequency - peak_freq_band_upp_limit) / half_count;
-                const double wave_heading_increment = M_PI/N;
+                const auto [frequencies, band_sizes] = calculate_frequency_bands();
+                const size_t half_count = (count_component_waves-1)/2; // Half of the component wave count
+                const double wave_heading_increment = M_PI/count_component_waves;
                 
                 // Lambda function to construct the wave
-                Eigen::Vector<double, N> amplitudes;
-                Eigen::Vector<double, N> frequencys;
-                Eigen::Vector<double, N> phases;
-                Eigen::Vector<double, N> wave_headings;
-                auto construct_regular_wave_parameters = [&](const double freq, const double freq_band_size, const double wave_heading, size_t i) {
-                    // Bretschneider spectrum
-                    // Ref: Proceedings of the 23rd ITTC - Vol II, Table A.2, A.3.
-                    // S(f) = (A/f^5) exp(-B/f^4)
-                    // A = alpha g^2 (2 PI)^-4
-                    // B = beta (2PI U/g)^-4
-                    // alpha = 0.0081
-                    // beta = 0.74
-                    // f_p = 0.946 B^(1/4)
-                    // U = wind speed in m/s
-                    constexpr double alpha = 0.0081;
-                    constexpr double beta = 0.74;
-                    const double A = alpha * Constants::G*Constants::G * pow(2.0*M_PI, -4.0);
-                    const double B = 4.0 * alpha * Constants::G*Constants::G / (pow(2.0*M_PI, 4.0) * significant_wave_height*significant_wave_height);
-                    const double S = (A / pow(freq, 5.0)) * exp(-B / pow(freq, 4.0)) * freq_band_size;
+                Eigen::VectorXd amplitudes(count_component_waves);
+                Eigen::VectorXd phases(count_component_waves);
+                Eigen::VectorXd wave_headings(count_component_waves);
+                auto construct_regular_wave_parameters = [&](const double wave_heading, size_t i) {
+                    const double S = get_spectral_density(frequencies(i)) * band_sizes(i);
                     const double amplitude = sqrt(2.0 * S); 
-                    const double phase = dist(rng);  // Generate a random number
+                    const double phase = M_PI * Random::get_uniform(random_number_seed, Random::STREAM_COMPONENT_PHASE, i); // Depends only on the seed and the index
                     amplitudes(i) = amplitude;
-                    frequencys(i) = freq;
                     phases(i) = phase;
                     wave_headings(i) = Geometry::switch_angle_frame(wave_heading); // Convert the heading to be relative to North, as the regular wave interface expects it in this format.
                 };
             
                 // Create wave parameters for - min to peak freq
-                double mu = -M_PI/2.0;
                 for(size_t i = 0; i < half_count; ++i) {
-                    const double freq = min_spectral_frequency + (i * frequency_band_size_min_to_peak) + frequency_band_size_min_to_peak/2.0;
                     const double mu = M_PI/2.0 - (i * wave_heading_increment) + wave_heading_increment/2.0;
                     const double wave_heading = Geometry::normalise_angle_PI(predominant_wave_heading + mu);
-                    construct_regular_wave_parameters(freq, frequency_band_size_min_to_peak, wave_heading, i);
+                    construct_regular_wave_parameters(wave_heading, i);
                 }
                 // Create wave parameters for - peak
-                construct_regular_wave_parameters(peak_spectral_frequency, frequency_band_size_peak, predominant_wave_heading, half_count);
+                construct_regular_wave_parameters(predominant_wave_heading, half_count);
                 // Create wave parameters for - peak to max freq
                 for(size_t i = 0; i < half_count; ++i) {
-                    const double freq = peak_freq_band_upp_limit + (i * frequency_band_size_peak_to_max) + frequency_band_size_peak_to_max/2.0;
                     const double mu = (i * wave_heading_increment) + wave_heading_increment/2.0;
                     const double wave_heading = Geometry::normalise_angle_PI(predominant_wave_heading - mu);
-                    construct_regular_wave_parameters(freq, frequency_band_size_peak_to_max, wave_heading, half_count+i);
+                    construct_regular_wave_parameters(wave_heading, half_count+1+i);
+                }
+
+                // Prune the weakest components
+                std::vector<size_t> retained(count_component_waves);
+                std::iota(retained.begin(), retained.end(), 0);
+                if(variance_tolerance > 0.0) {
+                    std::vector<size_t> ranked = retained;
+                    std::stable_sort(ranked.begin(), ranked.end(), [&](const size_t i, const size_t j) { return amplitudes(i) < amplitudes(j); });
+                    const double variance_budget = variance_tolerance * spectral_variance;
+                    double variance_dropped = 0.0;
+                    size_t count_dropped = 0;
+                    while(count_dropped < ranked.size() - 1 and variance_dropped + amplitudes(ranked[count_dropped])*amplitudes(ranked[count_dropped])/2.0 <= variance_budget) {
+                        variance_dropped += amplitudes(ranked[count_dropped])*amplitudes(ranked[count_dropped])/2.0;
+                        ++count_dropped;
+                    }
+                    retained.assign(ranked.begin() + count_dropped, ranked.end());
+                    std::sort(retained.begin(), retained.end());
                 }
                 // Create regular waves
-                RegularWave<N> spectrum {amplitudes, frequencys, phases, wave_headings}; 
+                RegularWave<N, Trig, Real> spectrum {amplitudes(retained), frequencies(retained), phases(retained), wave_headings(retained)}; 
                 return spectrum;
             }
             
     };
+
+
+    /**
+     * @brief Parameters of a sea state, as taken by the SeaSurface constructor.
+     */
+    struct SeaState {
+        /** @brief Significant wave height (in meters). */
+        double significant_wave_height;
+
+        /** @brief Predominant wave heading in radians, measured clockwise from geographic north. */
+        double predominant_wave_heading;
+
+        /** @brief Seed for the random number generator used in wave spectrum generation. */
+        int random_number_seed;
+
+        /** @brief Number of regular component waves. */
+        size_t count_component_waves;
+
+        /** @brief Fraction of the variance of the spectrum that may be dropped by pruning. */
+        double variance_tolerance = 0.0;
+    };
+
+
+    /**
+     * @brief Builds the sea surfaces of many sea states in parallel.
+     * 
+     * The sea states are shared out between the threads in turn. A sea surface depends only on its sea 
+     * state (see SeaSurface::calculate_wave_spectrum()), so the result is bit-identical for any number of threads.
+     * 
+     * @param sea_states Parameters of each sea surface.
+     * @param count_threads Number of threads to build on (must be positive). Defaults to the number of hardware threads.
+     * @return std::vector<std::shared_ptr<const SeaSurface<N, Trig, Real>>> The sea surfaces, in the order of sea_states.
+     * 
+     * @throws std::invalid_argument if count_threads is zero, or the first exception thrown by a SeaSurface 
+     *         constructor, once all threads have finished.
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double>
+    std::vector<std::shared_ptr<const SeaSurface<N, Trig, Real>>> build_sea_surfaces(const std::vector<SeaState>& sea_states, 
+                                                                                    const size_t count_threads = std::max(1u, std::thread::hardware_concurrency())) {
+        if(count_threads == 0) {
+            throw std::invalid_argument("Number of threads must be positive.");
+        }
+        std::vector<std::shared_ptr<const SeaSurface<N, Trig, Real>>> sea_surfaces(sea_states.size());
+        std::vector<std::exception_ptr> errors(sea_states.size());
+        std::atomic<size_t> next {0};
+        auto build = [&]() {
+            for(size_t i = next++; i < sea_states.size(); i = next++) {
+                const SeaState& sea_state = sea_states[i];
+                try {
+                    sea_surfaces[i] = std::make_shared<const SeaSurface<N, Trig, Real>>(sea_state.significant_wave_height, 
+                                                                                         sea_state.predominant_wave_heading, 
+                                                                                         sea_state.random_number_seed, 
+                                                                                         sea_state.count_component_waves, 
+                                                                                         sea_state.variance_tolerance);
+                } catch(...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for(size_t t = 1; t < std::min(count_threads, sea_states.size()); ++t) {
+            threads.emplace_back(build);
+        }
+        build();
+        for(std::thread& thread : threads) {
+            thread.join();
+        }
+        for(const std::exception_ptr& error : errors) {
+            if(error) {
+                std::rethrow_exception(error);
+            }
+        }
+        return sea_surfaces;
+    }
     
 }
\ No newline at end of file
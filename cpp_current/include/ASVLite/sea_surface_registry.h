@@ -0,0 +1,128 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "sea_surface.h"
+
+
+namespace ASVLite {
+
+    /**
+     * @brief Thread-safe cache of immutable sea surfaces, keyed by the parameters of the sea state.
+     *
+     * get_sea_surface() returns the sea surface already generated for the same significant wave height,
+     * predominant wave heading, random number seed, component count and variance tolerance, or generates
+     * and caches a new one. Vehicles and worker threads that simulate the same sea state then share one
+     * instance instead of each generating the spectrum. The parameters are matched exactly.
+     *
+     * The sea surfaces are handed out as std::shared_ptr<const SeaSurface>, so an instance stays valid for
+     * as long as a caller holds it, even after it is evicted. The cache holds at most capacity sea surfaces
+     * and evicts the least recently used one when full.
+     *
+     * @tparam N Number of regular component waves, or DYNAMIC (see SeaSurface).
+     * @tparam Trig Trigonometry policy of the sea surfaces.
+     * @tparam Real Scalar type of the sea surfaces.
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double>
+    class SeaSurfaceRegistry {
+
+        public:
+
+            /**
+             * @brief Constructs an empty registry.
+             *
+             * @param capacity Maximum number of sea surfaces held in the cache (must be positive).
+             *
+             * @throws std::invalid_argument if capacity is zero.
+             */
+            explicit SeaSurfaceRegistry(const size_t capacity) : capacity {capacity} {
+                if(capacity == 0) {
+                    throw std::invalid_argument("Registry capacity must be positive.");
+                }
+            }
+
+
+            /**
+             * @brief Returns the sea surface for a sea state, generating it on first use.
+             *
+             * The parameters are those of the SeaSurface constructor.
+             *
+             * @param significant_wave_height Significant wave height (in meters).
+             * @param predominant_wave_heading Predominant wave heading in radians, measured clockwise from geographic north.
+             * @param random_number_seed Seed for the random number generator used in wave spectrum generation.
+             * @param count_component_waves Number of regular component waves. Required for N = DYNAMIC, and must equal N otherwise.
+             * @param variance_tolerance Fraction of the variance of the spectrum that may be dropped by pruning. Only for N = DYNAMIC.
+             * @return std::shared_ptr<const SeaSurface<N, Trig, Real>> The shared sea surface.
+             *
+             * @throws std::invalid_argument if the SeaSurface constructor rejects the parameters. Nothing is cached in that case.
+             */
+            std::shared_ptr<const SeaSurface<N, Trig, Real>> get_sea_surface(const double significant_wave_height,
+                                                                             const double predominant_wave_heading,
+                                                                             const int random_number_seed,
+                                                                             const size_t count_component_waves = N,
+                                                                             const double variance_tolerance = 0.0) {
+                const Key key {significant_wave_height, predominant_wave_heading, random_number_seed, count_component_waves, variance_tolerance};
+                std::lock_guard<std::mutex> lock(mutex);
+                const auto it = index.find(key);
+                if(it != index.end()) {
+                    // Move to the front of the usage order.
+                    entries.splice(entries.begin(), entries, it->second);
+                    return it->second->second;
+                }
+                // Generate under the lock so that a sea state requested by several threads at once is generated only once.
+                auto sea_surface = std::make_shared<const SeaSurface<N, Trig, Real>>(significant_wave_height, predominant_wave_heading,
+                                                                                      random_number_seed, count_component_waves, variance_tolerance);
+                entries.emplace_front(key, sea_surface);
+                index.emplace(key, entries.begin());
+                if(entries.size() > capacity) {
+                    index.erase(entries.back().first);
+                    entries.pop_back();
+                }
+                return sea_surface;
+            }
+
+
+            /**
+             * @brief Returns the number of sea surfaces held in the cache.
+             */
+            size_t get_count() const {
+                std::lock_guard<std::mutex> lock(mutex);
+                return entries.size();
+            }
+
+
+            /**
+             * @brief Removes all sea surfaces from the cache. Sea surfaces held by callers stay valid.
+             */
+            void clear() {
+                std::lock_guard<std::mutex> lock(mutex);
+                index.clear();
+                entries.clear();
+            }
+
+
+            /** @brief Maximum number of sea surfaces held in the cache. */
+            const size_t capacity;
+
+
+        private:
+
+            /** @brief Significant wave height, predominant wave heading, seed, component count and variance tolerance. */
+            using Key = std::tuple<double, double, int, size_t, double>;
+
+            /** @brief Cached sea surfaces, most recently used first. */
+            std::list<std::pair<Key, std::shared_ptr<const SeaSurface<N, Trig, Real>>>> entries;
+
+            /** @brief Position of each cached sea surface in entries. */
+            std::map<Key, typename decltype(entries)::iterator> index;
+
+            /** @brief Guards entries and index. */
+            mutable std::mutex mutex;
+    };
+
+}
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <Eigen/Dense>
+#include <unsupported/Eigen/FFT>
+#include "geometry.h"
+#include "random.h"
+#include "sea_surface.h"
+#include "ASVLite/constants.h"
+
+
+namespace ASVLite {
+
+    /**
+     * @brief Models a square, periodic tile of an irregular sea surface on a regular grid.
+     *
+     * SeaSurface::get_elevation() sums the component waves at each point, so a field of P points costs
+     * P × N cosines. The tile instead discretises the Bretschneider spectrum of a SeaSurface onto the
+     * grid of wavenumbers (2PI/L) × (m, n) that are periodic over a tile of side L, and synthesises the
+     * elevation at all grid points of a time step with one inverse FFT, O(M² log M) for an M × M grid.
+     * Point queries are served by bilinear interpolation of the tile, and the tile repeats periodically
+     * in x and y, so a single tile covers a swarm of any extent.
+     *
+     * Each wavenumber bin k = (k_x, k_y) carries a regular wave of frequency sqrt(g|k|)/2PI, so the
+     * spectrum keeps the spectral frequency range of the sea surface, [min_spectral_frequency,
+     * max_spectral_frequency], and its heading range of +-PI/2 around the predominant wave heading,
+     * with the energy spread uniformly over the headings. Bins outside these ranges are empty. The
+     * amplitude of a bin is sqrt(2 × S(f) × D × (df/dk) × Δk² / |k|), where S(f) is the spectral density
+     * (see SeaSurface::get_spectral_density()), D = 1/PI and Δk = 2PI/L. The phase lags are uniform in
+     * [0, 2PI), keyed by the random number seed of the sea surface and the bin (see Random::get_uniform()),
+     * so the bins add incoherently at every point of the tile.
+     *
+     * The tile is a different realisation of the same sea state, not a resampling of the component
+     * waves of the SeaSurface. Its statistics approach those of the sea state when the grid resolves the
+     * spectrum: L should be several times the wavelength at min_spectral_frequency, and the grid spacing
+     * L/M less than half the wavelength at max_spectral_frequency.
+     */
+    class SeaSurfaceTile {
+
+        public:
+
+            /**
+             * @brief Constructs a tile of the sea state of a sea surface, at time zero.
+             *
+             * @param sea_surface Sea surface whose sea state is discretised.
+             * @param tile_length Side of the tile in meters (must be positive).
+             * @param grid_size Number of grid points along each side of the tile (must be an even number >= 2).
+             *        The FFT is fastest for powers of two.
+             * @param origin Coordinates (in meters) of the grid point (0, 0). Only x and y are used.
+             *
+             * @throws std::invalid_argument if tile_length is not positive or grid_size is not an even number >= 2.
+             */
+            template<size_t N, typename Trig, typename Real>
+            SeaSurfaceTile(const SeaSurface<N, Trig, Real>& sea_surface,
+                           const double tile_length,
+                           const size_t grid_size,
+                           const Geometry::Coordinates3D& origin = {0.0, 0.0, 0.0}) :
+            tile_length {tile_length},
+            grid_size {grid_size},
+            grid_spacing {tile_length / grid_size},
+            origin {origin},
+            amplitude {Eigen::ArrayXXd::Zero(grid_size, grid_size)},
+            phase_lag {Eigen::ArrayXXd::Zero(grid_size, grid_size)},
+            angular_frequency {Eigen::ArrayXXd::Zero(grid_size, grid_size)},
+            spectrum(grid_size, grid_size),
+            buffer(grid_size),
+            transform(grid_size),
+            elevation(grid_size, grid_size) {
+                if(tile_length <= 0.0) {
+                    throw std::invalid_argument("Tile length must be positive.");
+                }
+                if(grid_size < 2 or grid_size % 2 != 0) {
+                    throw std::invalid_argument("Grid size must be an even number greater than or equal to 2.");
+                }
+                set_spectrum(sea_surface);
+                fft.SetFlag(Eigen::FFT<double>::Unscaled);
+                set_time(0.0);
+            }
+
+
+            /**
+             * @brief Synthesises the elevation of the tile at a given time.
+             *
+             * Does not allocate, so it can be called every time step of a simulation.
+             *
+             * @param time Time in seconds since the start of the simulation (must be non-negative).
+             *
+             * @throws std::invalid_argument if time is negative.
+             */
+            void set_time(const double time) {
+                if(time < 0.0) {
+                    throw std::invalid_argument("Time cannot be negative.");
+                }
+                this->time = time;
+                // Complex amplitude of each bin, amplitude × exp(i × (phase_lag - angular_frequency × time)).
+                spectrum.real() = amplitude * (phase_lag - angular_frequency * time).cos();
+                spectrum.imag() = amplitude * (phase_lag - angular_frequency * time).sin();
+                // Inverse 2D transform, as 1D transforms of the columns then the rows.
+                // elevation(p, q) = Re sum_{m, n} spectrum(m, n) × exp(i × 2PI × (m × p + n × q) / M)
+                for(Eigen::Index n = 0; n < spectrum.cols(); ++n) {
+                    buffer = spectrum.col(n);
+                    fft.inv(transform.data(), buffer.data(), grid_size);
+                    spectrum.col(n) = transform;
+                }
+                for(Eigen::Index p = 0; p < spectrum.rows(); ++p) {
+                    buffer = spectrum.row(p).transpose();
+                    fft.inv(transform.data(), buffer.data(), grid_size);
+                    elevation.row(p) = transform.real().transpose();
+                }
+            }
+
+
+            /**
+             * @brief Returns the time of the tile.
+             *
+             * @return double Time in seconds since the start of the simulation.
+             */
+            double get_time() const {
+                return time;
+            }
+
+
+            /**
+             * @brief Computes the sea surface elevation at a given location, at the time of the tile.
+             *
+             * Bilinear interpolation between the four grid points around the location. The tile is periodic,
+             * so any location is valid.
+             *
+             * @param location 3D coordinates (in meters) where elevation is evaluated. Only x and y are used.
+             * @return double Sea surface elevation in meters.
+             */
+            double get_elevation(const Geometry::Coordinates3D& location) const {
+                const auto [p_0, u] = get_grid_index(location.keys.x - origin.keys.x);
+                const auto [q_0, v] = get_grid_index(location.keys.y - origin.keys.y);
+                const Eigen::Index p_1 = (p_0 + 1) % elevation.rows();
+                const Eigen::Index q_1 = (q_0 + 1) % elevation.cols();
+                return (1.0 - u) * ((1.0 - v) * elevation(p_0, q_0) + v * elevation(p_0, q_1)) +
+                              u  * ((1.0 - v) * elevation(p_1, q_0) + v * elevation(p_1, q_1));
+            }
+
+
+            /**
+             * @brief Computes the wave pressure amplitude at a given location, at the time of the tile.
+             *
+             * Same convention as RegularWave::get_wave_pressure(), -ρ × g × elevation.
+             *
+             * @param location 3D coordinates (in meters) where the pressure is evaluated. Only x and y are used.
+             * @return double Wave pressure amplitude in N/m².
+             */
+            double get_wave_pressure(const Geometry::Coordinates3D& location) const {
+                return -Constants::SEA_WATER_DENSITY * Constants::G * get_elevation(location);
+            }
+
+
+            /**
+             * @brief Returns the elevation at the grid points, at the time of the tile.
+             *
+             * @return const Eigen::ArrayXXd& Elevation in meters. Element (p, q) is at
+             *         (origin.x + p × grid_spacing, origin.y + q × grid_spacing).
+             */
+            const Eigen::ArrayXXd& get_elevation_field() const {
+                return elevation;
+            }
+
+
+            /**
+             * @brief Computes the wave pressure amplitude at the grid points, at the time of the tile.
+             *
+             * @return Eigen::ArrayXXd Wave pressure amplitude in N/m², indexed as get_elevation_field().
+             */
+            Eigen::ArrayXXd get_wave_pressure_field() const {
+                return -Constants::SEA_WATER_DENSITY * Constants::G * elevation;
+            }
+
+
+            // Input variables
+            // ---------------
+            /** @brief Side of the tile (in meters). */
+            const double tile_length;
+
+            /** @brief Number of grid points along each side of the tile. */
+            const size_t grid_size;
+
+            // Calculated variables
+            // --------------------
+            /** @brief Distance between neighbouring grid points (in meters). */
+            const double grid_spacing;
+
+
+        private:
+
+            /**
+             * @brief Sets the amplitude, phase lag and angular frequency of each wavenumber bin.
+             *
+             * Bin (m, n) has wavenumber (2PI/L) × (m', n'), where m' = m for m < M/2 and m - M otherwise.
+             * The bins at the Nyquist wavenumber, m' or n' = -M/2, are ambiguous in direction and left empty.
+             */
+            template<size_t N, typename Trig, typename Real>
+            void set_spectrum(const SeaSurface<N, Trig, Real>& sea_surface) {
+                const double delta_k = 2.0 * M_PI / tile_length;
+                const double spreading = 1.0 / M_PI; // Energy spread uniformly over the headings in +-PI/2.
+                const Eigen::Index half_size = grid_size / 2;
+                for(Eigen::Index n = 0; n < static_cast<Eigen::Index>(grid_size); ++n) {
+                    for(Eigen::Index m = 0; m < static_cast<Eigen::Index>(grid_size); ++m) {
+                        const Eigen::Index m_signed = (m < half_size) ? m : m - static_cast<Eigen::Index>(grid_size);
+                        const Eigen::Index n_signed = (n < half_size) ? n : n - static_cast<Eigen::Index>(grid_size);
+                        if(m_signed == -half_size or n_signed == -half_size) {
+                            continue;
+                        }
+                        const double k_x = m_signed * delta_k;
+                        const double k_y = n_signed * delta_k;
+                        const double k = std::hypot(k_x, k_y);
+                        if(k == 0.0) {
+                            continue;
+                        }
+                        // Deep water dispersion, omega² = g k.
+                        const double omega = std::sqrt(Constants::G * k);
+                        const double frequency = omega / (2.0 * M_PI);
+                        const double relative_heading = Geometry::normalise_angle_PI(std::atan2(k_y, k_x) - sea_surface.predominant_wave_heading);
+                        if(frequency < sea_surface.min_spectral_frequency or frequency > sea_surface.max_spectral_frequency or
+                           std::abs(relative_heading) >= M_PI/2.0) {
+                            continue;
+                        }
+                        // S(f) df dθ = S(f) (df/dk) (1/k) dk_x dk_y
+                        const double df_dk = std::sqrt(Constants::G / k) / (4.0 * M_PI);
+                        const double S = sea_surface.get_spectral_density(frequency) * spreading * df_dk * delta_k * delta_k / k;
+                        amplitude(m, n) = std::sqrt(2.0 * S);
+                        phase_lag(m, n) = 2.0 * M_PI * Random::get_uniform(sea_surface.random_number_seed, Random::STREAM_TILE_PHASE, n * grid_size + m);
+                        angular_frequency(m, n) = omega;
+                    }
+                }
+            }
+
+
+            /**
+             * @brief Returns the grid index below a distance from the origin along one axis, and the fraction of the
+             *        grid spacing beyond it, wrapping the distance into the tile.
+             */
+            std::pair<Eigen::Index, double> get_grid_index(const double distance) const {
+                double wrapped = std::fmod(distance, tile_length);
+                if(wrapped < 0.0) {
+                    wrapped += tile_length;
+                }
+                const double position = wrapped / grid_spacing;
+                const Eigen::Index index = std::min(static_cast<Eigen::Index>(position), static_cast<Eigen::Index>(grid_size) - 1);
+                return {index, position - index};
+            }
+
+
+            /** @brief Coordinates of the grid point (0, 0) (in meters). */
+            const Geometry::Coordinates3D origin;
+
+            /** @brief Amplitude of the regular wave in each wavenumber bin (m). */
+            Eigen::ArrayXXd amplitude;
+
+            /** @brief Phase lag of the regular wave in each wavenumber bin (radian). */
+            Eigen::ArrayXXd phase_lag;
+
+            /** @brief Angular frequency of the regular wave in each wavenumber bin (radian/sec). */
+            Eigen::ArrayXXd angular_frequency;
+
+            /** @brief Complex amplitudes of the bins at the current time, and the workspace of the inverse transform. */
+            Eigen::ArrayXXcd spectrum;
+
+            /** @brief Contiguous copy of the column or row being transformed. */
+            Eigen::VectorXcd buffer;
+
+            /** @brief Result of a 1D inverse transform. */
+            Eigen::VectorXcd transform;
+
+            /** @brief Elevation at the grid points at the current time (m). */
+            Eigen::ArrayXXd elevation;
+
+            /** @brief FFT engine, unscaled so that the inverse transform is the plain sum over the bins. */
+            Eigen::FFT<double> fft;
+
+            /** @brief Time of the tile (sec). */
+            double time {0.0};
+    };
+
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "geometry.h"
+#include "sea_surface.h"
+#include "asv.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace ASVLite {
+
+    /**
+     * @brief Steps a swarm of ASVs sharing one sea surface in parallel, on a persistent pool of threads.
+     *
+     * Every vehicle is an Asv, so a vehicle in the swarm follows the same trajectory as a standalone Asv with the
+     * same inputs, bit for bit, whatever the number of threads. Each call of step_simulation() advances every vehicle
+     * by one time step on the threads of a ThreadPool, in chunks of vehicles with work stealing, and returns when all
+     * are done, so the vehicles stay in lockstep.
+     *
+     * The thrust of a vehicle comes from its controller, if it has one, called at each time step on the thread that
+     * steps the vehicle, or else from the last call of set_thrust(). A controller is called concurrently with the
+     * controllers of other vehicles, so controllers must not share mutable state.
+     *
+     * @tparam N, Trig, Real, Structure, Integrator The template parameters of the vehicles (see Asv).
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double, typename Structure = MatrixStructure::Diagonal,
+             typename Integrator = Integration::SemiImplicitEuler>
+    class Swarm {
+
+        public:
+
+            /** @brief Type of the vehicles. */
+            using Vehicle = Asv<N, Trig, Real, Structure, Integrator>;
+
+            /** @brief Controller of a vehicle, returning the thrust position and magnitude for the next time step (see get_wave_glider_thrust()). */
+            using Controller = std::function<std::pair<Geometry::Coordinates3D, Geometry::Coordinates3D>(const Vehicle&)>;
+
+
+            /**
+             * @brief Constructs an empty swarm in a given sea environment and starts its threads.
+             *
+             * @param sea_surface Pointer to the sea surface shared by all vehicles (must not be nullptr).
+             * @param count_threads Number of threads to step the vehicles on, including the calling thread (must be positive).
+             *        Defaults to the number of hardware threads.
+             * @param chunk_size Number of vehicles stepped as one unit of work (must be positive).
+             *
+             * @throws std::invalid_argument if sea_surface is a nullptr, or count_threads or chunk_size is zero.
+             */
+            Swarm(const SeaSurface<N, Trig, Real>* sea_surface,
+                  const size_t count_threads = std::max(1u, std::thread::hardware_concurrency()),
+                  const size_t chunk_size = 64) :
+            sea_surface {sea_surface},
+            chunk_size {chunk_size},
+            thread_pool {count_threads} {
+                if(sea_surface == nullptr) {
+                    throw std::invalid_argument("Sea surface cannot be nullptr.");
+                }
+                if(chunk_size == 0) {
+                    throw std::invalid_argument("Chunk size must be positive.");
+                }
+            }
+
+
+            /**
+             * @brief Adds a vehicle to the swarm, at the current time of the swarm.
+             *
+             * @param spec ASV geometric specifications.
+             * @param position Initial position of the ASV on the sea surface (in meters).
+             * @param attitude Initial attitude of the ASV (roll, pitch, yaw in radians, yaw is w.r.t. geographic north).
+             * @param controller Controller of the vehicle, or an empty function to set its thrust with set_thrust().
+             * @return size_t Index of the vehicle in the swarm.
+             */
+            size_t add_vehicle(const AsvSpecification& spec,
+                               const Geometry::Coordinates3D& position,
+                               const Geometry::Coordinates3D& attitude,
+                               const Controller& controller = Controller()) {
+                Vehicle vehicle {spec, sea_surface, position, attitude};
+                if(!vehicles.empty()) {
+                    // Bring the new vehicle to the time of the swarm, on the sea surface at that time.
+                    AsvState<N, Trig, Real, Structure, Integrator> state = vehicle.save_state();
+                    state.dynamics.time = time;
+                    state.dynamics.position.keys.z = sea_surface->get_elevation(position, time);
+                    vehicle.restore_state(state);
+                }
+                vehicles.push_back(std::move(vehicle));
+                controllers.push_back(controller);
+                thrusts.emplace_back(Geometry::Coordinates3D {-spec.L_wl/2.0, 0.0, 0.0}, Geometry::Coordinates3D {0.0, 0.0, 0.0});
+                return vehicles.size() - 1;
+            }
+
+
+            /**
+             * @brief Sets the thrust of a vehicle without a controller, held until the next call.
+             *
+             * @param k Index of the vehicle.
+             * @param thrust_position Point of thrust application in body-fixed coordinates.
+             * @param thrust_magnitude Vector representing the magnitude and direction of applied thrust.
+             *
+             * @throws std::out_of_range if k is not the index of a vehicle.
+             */
+            void set_thrust(const size_t k, const Geometry::Coordinates3D& thrust_position, const Geometry::Coordinates3D& thrust_magnitude) {
+                if(k >= vehicles.size()) {
+                    throw std::out_of_range("Vehicle index out of range.");
+                }
+                thrusts[k] = {thrust_position, thrust_magnitude};
+            }
+
+
+            /**
+             * @brief Advances every vehicle by one time step.
+             *
+             * @throws The first exception thrown by a controller or a vehicle, once all vehicles have been stepped.
+             */
+            void step_simulation() {
+                thread_pool.parallel_for(vehicles.size(), chunk_size, [this](const size_t begin, const size_t end) {
+                    for(size_t k = begin; k < end; ++k) {
+                        Vehicle& vehicle = vehicles[k];
+                        if(controllers[k]) {
+                            thrusts[k] = controllers[k](vehicle);
+                        }
+                        vehicle.step_simulation(thrusts[k].first, thrusts[k].second);
+                    }
+                });
+                if(!vehicles.empty()) {
+                    time = vehicles.front().get_time();
+                }
+            }
+
+
+            /**
+             * @brief Returns the number of vehicles in the swarm.
+             */
+            size_t get_count_vehicles() const {
+                return vehicles.size();
+            }
+
+
+            /**
+             * @brief Returns a vehicle of the swarm.
+             *
+             * @throws std::out_of_range if k is not the index of a vehicle.
+             */
+            const Vehicle& get_vehicle(const size_t k) const {
+                if(k >= vehicles.size()) {
+                    throw std::out_of_range("Vehicle index out of range.");
+                }
+                return vehicles[k];
+            }
+
+
+            /**
+             * @brief Returns the time of the swarm in seconds since the start of the simulation.
+             */
+            double get_time() const {
+                return time;
+            }
+
+
+            /**
+             * @brief Returns the number of threads the vehicles are stepped on.
+             */
+            size_t get_count_threads() const {
+                return thread_pool.get_count_threads();
+            }
+
+
+        private:
+
+            /** @brief Sea surface shared by all vehicles. */
+            const SeaSurface<N, Trig, Real>* sea_surface;
+
+            /** @brief Number of vehicles stepped as one unit of work. */
+            const size_t chunk_size;
+
+            /** @brief Vehicles of the swarm. */
+            std::vector<Vehicle> vehicles;
+
+            /** @brief Controller of each vehicle, empty for a vehicle without a controller. */
+            std::vector<Controller> controllers;
+
+            /** @brief Thrust position and magnitude of each vehicle, for the next time step. */
+            std::vector<std::pair<Geometry::Coordinates3D, Geometry::Coordinates3D>> thrusts;
+
+            /** @brief Time of the swarm (in seconds). */
+            double time {0.0};
+
+            /** @brief Threads the vehicles are stepped on. */
+            ThreadPool thread_pool;
+    };
+
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace ASVLite {
+
+    /**
+     * @brief Persistent pool of threads running data-parallel loops with work stealing.
+     *
+     * The threads are started once and sleep between loops, so a loop per time step costs a wake-up and not
+     * a thread start. A loop over count items is cut into chunks of chunk_size items, and the chunks are dealt
+     * out in contiguous runs, one run per thread. Each thread takes chunks from the front of its own run and,
+     * once it is empty, steals chunks from the back of the runs of the other threads, so threads that finish
+     * early take over the work of slow ones without a shared queue. parallel_for() returns when every chunk is
+     * done, which is the barrier between successive loops.
+     *
+     * The calling thread works as one of the threads of the pool. A pool runs one loop at a time and
+     * parallel_for() must not be called from within a loop.
+     */
+    class ThreadPool {
+
+        public:
+
+            /**
+             * @brief Starts the threads of the pool.
+             *
+             * @param count_threads Number of threads to run the loops on, including the calling thread (must be positive).
+             *        Defaults to the number of hardware threads.
+             *
+             * @throws std::invalid_argument if count_threads is zero.
+             */
+            explicit ThreadPool(const size_t count_threads = std::max(1u, std::thread::hardware_concurrency())) :
+            count_threads {count_threads} {
+                if(count_threads == 0) {
+                    throw std::invalid_argument("Number of threads must be positive.");
+                }
+                runs = std::make_unique<Run[]>(count_threads);
+                for(size_t t = 1; t < count_threads; ++t) {
+                    threads.emplace_back(&ThreadPool::work, this, t);
+                }
+            }
+
+
+            /**
+             * @brief Stops and joins the threads of the pool.
+             */
+            ~ThreadPool() {
+                {
+                    const std::lock_guard<std::mutex> lock {mutex};
+                    is_stopping = true;
+                }
+                start_condition.notify_all();
+                for(std::thread& thread : threads) {
+                    thread.join();
+                }
+            }
+
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+
+            /**
+             * @brief Calls function(begin, end) for chunks [begin, end) covering [0, count) on the threads of the pool,
+             *        and returns when all are done.
+             *
+             * @param count Number of items.
+             * @param chunk_size Number of items per chunk (must be positive). Small enough for a few chunks per thread
+             *        to balance the load, and large enough for a chunk to outweigh the cost of taking it.
+             * @param function Callable as function(size_t begin, size_t end), for disjoint chunks, from several threads at once.
+             *
+             * @throws std::invalid_argument if chunk_size is zero or there are more than 2^32 - 1 chunks.
+             * @throws The first exception thrown by function, once all chunks are done.
+             */
+            template<typename Function>
+            void parallel_for(const size_t count, const size_t chunk_size, Function&& function) {
+                if(chunk_size == 0) {
+                    throw std::invalid_argument("Chunk size must be positive.");
+                }
+                const size_t count_chunks = (count + chunk_size - 1) / chunk_size;
+                if(count_chunks > UINT32_MAX) {
+                    throw std::invalid_argument("Too many chunks.");
+                }
+                if(count_chunks == 0) {
+                    return;
+                }
+                this->count = count;
+                this->chunk_size = chunk_size;
+                context = &function;
+                invoke = [](void* context, const size_t begin, const size_t end) {
+                    (*static_cast<std::remove_reference_t<Function>*>(context))(begin, end);
+                };
+                error = nullptr;
+                for(size_t t = 0; t < count_threads; ++t) {
+                    runs[t].chunks.store(pack(count_chunks * t / count_threads, count_chunks * (t + 1) / count_threads));
+                }
+                if(!threads.empty()) {
+                    count_working.store(threads.size());
+                    {
+                        const std::lock_guard<std::mutex> lock {mutex};
+                        ++generation;
+                    }
+                    start_condition.notify_all();
+                }
+                run(0);
+                if(!threads.empty()) {
+                    wait([&]() { return count_working.load() == 0; }, end_condition);
+                }
+                if(error) {
+                    std::rethrow_exception(error);
+                }
+            }
+
+
+            /**
+             * @brief Returns the number of threads the loops run on, including the calling thread.
+             */
+            size_t get_count_threads() const {
+                return count_threads;
+            }
+
+
+        private:
+
+            /**
+             * @brief Chunks left in the run of a thread, the first in the upper and one past the last in the lower 32 bits.
+             *
+             * On its own cache line, as the owner and the thieves update it concurrently.
+             */
+            struct alignas(64) Run {
+                std::atomic<uint64_t> chunks {0};
+            };
+
+
+            static uint64_t pack(const uint64_t begin, const uint64_t end) {
+                return (begin << 32) | end;
+            }
+
+
+            /**
+             * @brief Takes a chunk from the front of a run if take_front is true, else from the back.
+             *
+             * @return true and the chunk, or false if the run is empty.
+             */
+            static bool take(Run& run, const bool take_front, size_t& chunk) {
+                uint64_t chunks = run.chunks.load();
+                while(true) {
+                    const uint64_t begin = chunks >> 32;
+                    const uint64_t end = chunks & UINT32_MAX;
+                    if(begin >= end) {
+                        return false;
+                    }
+                    const uint64_t remaining = take_front ? pack(begin + 1, end) : pack(begin, end - 1);
+                    if(run.chunks.compare_exchange_weak(chunks, remaining)) {
+                        chunk = take_front ? begin : end - 1;
+                        return true;
+                    }
+                }
+            }
+
+
+            /**
+             * @brief Runs the chunks of thread t, then steals chunks from the other threads until none are left.
+             */
+            void run(const size_t t) {
+                size_t chunk;
+                for(size_t i = 0; i < count_threads; ++i) {
+                    const size_t victim = (t + i) % count_threads;
+                    while(take(runs[victim], victim == t, chunk)) {
+                        try {
+                            invoke(context, chunk * chunk_size, std::min(count, (chunk + 1) * chunk_size));
+                        } catch(...) {
+                            const std::lock_guard<std::mutex> lock {error_mutex};
+                            if(!error) {
+                                error = std::current_exception();
+                            }
+                        }
+                    }
+                }
+            }
+
+
+            /**
+             * @brief Waits for a condition, spinning briefly before sleeping, as successive loops tend to follow
+             *        each other closely.
+             */
+            template<typename Predicate>
+            void wait(Predicate is_done, std::condition_variable& condition) {
+                constexpr size_t count_spins = 2048;
+                for(size_t i = 0; i < count_spins and !is_done(); ++i) {
+                    std::this_thread::yield();
+                }
+                std::unique_lock<std::mutex> lock {mutex};
+                condition.wait(lock, is_done);
+            }
+
+
+            /**
+             * @brief Loop of the worker thread t: waits for a loop to start, runs it and signals the end.
+             */
+            void work(const size_t t) {
+                uint64_t last_generation = 0;
+                while(true) {
+                    wait([&]() { return is_stopping or generation.load() != last_generation; }, start_condition);
+                    {
+                        const std::lock_guard<std::mutex> lock {mutex};
+                        if(is_stopping) {
+                            return;
+                        }
+                        last_generation = generation.load();
+                    }
+                    run(t);
+                    if(count_working.fetch_sub(1) == 1) {
+                        const std::lock_guard<std::mutex> lock {mutex};
+                        end_condition.notify_one();
+                    }
+                }
+            }
+
+
+            /** @brief Number of threads, including the calling thread. */
+            const size_t count_threads;
+
+            /** @brief Worker threads, one fewer than count_threads. */
+            std::vector<std::thread> threads;
+
+            /** @brief Chunks left in the run of each thread. */
+            std::unique_ptr<Run[]> runs;
+
+            /** @brief Function of the current loop, called through invoke. */
+            void* context {nullptr};
+            void (*invoke)(void*, size_t, size_t) {nullptr};
+
+            /** @brief Number of items and chunk size of the current loop. */
+            size_t count {0};
+            size_t chunk_size {1};
+
+            /** @brief First exception thrown by the function of the current loop. */
+            std::exception_ptr error;
+            std::mutex error_mutex;
+
+            /** @brief Guards the start and the end of the loops, and the stop of the pool. */
+            std::mutex mutex;
+            std::condition_variable start_condition;
+            std::condition_variable end_condition;
+
+            /** @brief Number of the current loop, incremented to start a loop. */
+            std::atomic<uint64_t> generation {0};
+
+            /** @brief Number of worker threads yet to finish the current loop. */
+            std::atomic<size_t> count_working {0};
+
+            /** @brief Set to stop the worker threads. */
+            std::atomic<bool> is_stopping {false};
+    };
+
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+#include <Eigen/Dense>
+#include "geometry.h"
+
+namespace ASVLite {
+
+    /**
+     * @brief Trigonometry policies for the wave and vehicle kernels.
+     *
+     * RegularWave, SeaSurface, Asv and AsvBatch take a policy as a template parameter and use it for
+     * every cosine, sine and angle normalisation evaluated per time step. A policy provides static
+     * member functions cos(), sin() and normalise_angle_PI() that take an Eigen array expression and
+     * return a plain array of the same shape, and overloads that write the result into a given array
+     * of that shape instead, so that kernels over dynamic-size arrays do not allocate.
+     *
+     * Constants computed once at construction (e.g. the direction cosines of the wave headings) are
+     * always evaluated with the standard library.
+     */
+    namespace Trigonometry {
+
+        /**
+         * @brief Standard library trigonometry.
+         *
+         * Correctly rounded to within an ulp, but Eigen evaluates double precision cosines one
+         * element at a time and the angle normalisation uses fmod.
+         */
+        struct Exact {
+
+            /**
+             * @brief Element-wise cosine.
+             */
+            template<typename Derived>
+            static typename Derived::PlainObject cos(const Eigen::ArrayBase<Derived>& x) {
+                return x.cos();
+            }
+
+            /**
+             * @brief Element-wise cosine, written into result. result may alias x.
+             */
+            template<typename Derived, typename Result>
+            static void cos(const Eigen::ArrayBase<Derived>& x, const Eigen::ArrayBase<Result>& result) {
+                result.const_cast_derived() = x.cos();
+            }
+
+            /**
+             * @brief Element-wise sine.
+             */
+            template<typename Derived>
+            static typename Derived::PlainObject sin(const Eigen::ArrayBase<Derived>& x) {
+                return x.sin();
+            }
+
+            /**
+             * @brief Element-wise sine, written into result. result may alias x.
+             */
+            template<typename Derived, typename Result>
+            static void sin(const Eigen::ArrayBase<Derived>& x, const Eigen::ArrayBase<Result>& result) {
+                result.const_cast_derived() = x.sin();
+            }
+
+            /**
+             * @brief Element-wise normalisation of angles to the range (-PI, PI]. See Geometry::normalise_angle_PI().
+             */
+            template<typename Derived>
+            static typename Derived::PlainObject normalise_angle_PI(const Eigen::ArrayBase<Derived>& x) {
+                typename Derived::PlainObject result;
+                result.resize(x.rows(), x.cols());
+                normalise_angle_PI(x, result);
+                return result;
+            }
+
+            /**
+             * @brief Element-wise normalisation of angles to the range (-PI, PI], written into result. result may alias x.
+             */
+            template<typename Derived, typename Result>
+            static void normalise_angle_PI(const Eigen::ArrayBase<Derived>& x, const Eigen::ArrayBase<Result>& result) {
+                using Scalar = typename Derived::Scalar;
+                result.const_cast_derived() = x.unaryExpr([](const Scalar angle) { return static_cast<Scalar>(Geometry::normalise_angle_PI(angle)); });
+            }
+        };
+
+
+        /**
+         * @brief Polynomial trigonometry built only from element-wise arithmetic, so Eigen vectorises it.
+         *
+         * Angles are reduced to [-PI, PI] by subtracting the nearest multiple of 2PI, using a two part
+         * (Cody-Waite) representation of 2PI. The cosine of the reduced angle r is evaluated as
+         * -sin(|r| - PI/2) with the odd Taylor polynomial of sin up to the 15th degree, whose truncation
+         * error on [-PI/2, PI/2] is below 7e-12. There are no branches or table lookups.
+         *
+         * Maximum absolute error against std::cos/std::sin: 1e-11 for |x| <= 1e5 and 2e-10 for
+         * |x| <= 1e6. Beyond that the error of the range reduction grows as about |x| × 1e-16, the
+         * same order as the rounding error already present in the argument. For single precision
+         * arguments the error is a few units of float rounding (below 4e-7), provided the arguments were reduced in 
+         * double precision first (see reduce_phase()).
+         */
+        struct Fast {
+
+            /** @brief High part of 2PI, exactly representable with trailing zero bits. */
+            static constexpr double TWO_PI_HI = 6.28318530717958623200e+00;
+
+            /** @brief Low part of 2PI, 2PI - TWO_PI_HI. */
+            static constexpr double TWO_PI_LO = 2.44929359829470635445e-16;
+
+            /**
+             * @brief Element-wise reduction of angles to the range [-PI, PI].
+             *
+             * Branch-free vectorised counterpart of Geometry::normalise_angle_PI(). Angles that are odd
+             * multiples of PI may map to either end of the range.
+             */
+            template<typename Derived>
+            static typename Derived::PlainObject normalise_angle_PI(const Eigen::ArrayBase<Derived>& x) {
+                typename Derived::PlainObject result;
+                result.resize(x.rows(), x.cols());
+                normalise_angle_PI(x, result);
+                return result;
+            }
+
+            /**
+             * @brief Element-wise reduction of angles to the range [-PI, PI], written into result. result may alias x.
+             */
+            template<typename Derived, typename Result>
+            static void normalise_angle_PI(const Eigen::ArrayBase<Derived>& x, const Eigen::ArrayBase<Result>& result) {
+                using Scalar = typename Derived::Scalar;
+                // The multiple of 2PI is evaluated per element in the expression, and not stored, so that result may alias x.
+                const auto q = (x * Scalar(1.0 / (2.0 * M_PI))).round();
+                result.const_cast_derived() = (x - q * Scalar(TWO_PI_HI)) - q * Scalar(TWO_PI_LO);
+            }
+
+            /**
+             * @brief Element-wise cosine.
+             */
+            template<typename Derived>
+            static typename Derived::PlainObject cos(const Eigen::ArrayBase<Derived>& x) {
+                typename Derived::PlainObject result;
+                result.resize(x.rows(), x.cols());
+                cos(x, result);
+                return result;
+            }
+
+            /**
+             * @brief Element-wise cosine, written into result. result may alias x.
+             */
+            template<typename Derived, typename Result>
+            static void cos(const Eigen::ArrayBase<Derived>& x, const Eigen::ArrayBase<Result>& result) {
+                // cos(r) = cos(|r|) = -sin(|r| - PI/2), with |r| - PI/2 in [-PI/2, PI/2].
+                using Scalar = typename Derived::Scalar;
+                Result& z = result.const_cast_derived();
+                normalise_angle_PI(x, z);
+                z = z.abs() - Scalar(M_PI/2.0);
+                set_sin_polynomial(z);
+                z = -z;
+            }
+
+            /**
+             * @brief Element-wise sine.
+             */
+            template<typename Derived>
+            static typename Derived::PlainObject sin(const Eigen::ArrayBase<Derived>& x) {
+                using Scalar = typename Derived::Scalar;
+                return cos(x - Scalar(M_PI/2.0));
+            }
+
+            /**
+             * @brief Element-wise sine, written into result. result may alias x.
+             */
+            template<typename Derived, typename Result>
+            static void sin(const Eigen::ArrayBase<Derived>& x, const Eigen::ArrayBase<Result>& result) {
+                using Scalar = typename Derived::Scalar;
+                cos(x - Scalar(M_PI/2.0), result);
+            }
+
+            private:
+
+            /**
+             * @brief Replaces each z in [-PI/2, PI/2] by the Taylor polynomial of sin(z) up to z^15 (z^11 for float).
+             */
+            template<typename Derived>
+            static void set_sin_polynomial(Eigen::ArrayBase<Derived>& z) {
+                using Scalar = typename Derived::Scalar;
+                // Horner scheme with the coefficients (-1)^n / (2n+1)!
+                if constexpr (std::is_same_v<Scalar, float>) {
+                    // Truncation error below 6e-8, the resolution of float.
+                    const auto z2 = z.square();
+                    z = z * (1.0f + z2 * (-1.0f/6.0f + z2 * (1.0f/120.0f + z2 * (-1.0f/5040.0f 
+                             + z2 * (1.0f/362880.0f + z2 * (-1.0f/39916800.0f))))));
+                } else {
+                    const auto z2 = z.square();
+                    z = z * (Scalar(1.0) + z2 * (Scalar(-1.0/6.0) + z2 * (Scalar(1.0/120.0) + z2 * (Scalar(-1.0/5040.0) 
+                             + z2 * (Scalar(1.0/362880.0) + z2 * (Scalar(-1.0/39916800.0) + z2 * (Scalar(1.0/6227020800.0) 
+                             + z2 * Scalar(-1.0/1307674368000.0))))))));
+                }
+            }
+        };
+
+
+        /**
+         * @brief Converts wave phases to the scalar type in which the waves are evaluated.
+         *
+         * Phases grow with time and distance travelled, so they are always computed in double 
+         * precision. When Real is narrower than double the phases are first reduced to [-PI, PI] in 
+         * double precision, so that the conversion only rounds the reduced angle. For Real = double
+         * the phases are returned unchanged.
+         *
+         * @tparam Real Scalar type of the returned phases.
+         * @param phase Phases in radians, in double precision.
+         * @return Phases in radians as an array of Real.
+         */
+        template<typename Real, typename Derived>
+        Eigen::Array<Real, Derived::RowsAtCompileTime, Derived::ColsAtCompileTime> reduce_phase(const Eigen::ArrayBase<Derived>& phase) {
+            if constexpr (std::is_same_v<Real, double>) {
+                return phase;
+            } else {
+                return Fast::normalise_angle_PI(phase).template cast<Real>();
+            }
+        }
+
+
+        /**
+         * @brief Converts wave phases to the scalar type in which the waves are evaluated, written into result. 
+         *        See reduce_phase(const Eigen::ArrayBase<Derived>&).
+         *
+         * When Real is narrower than double, phase is reduced in place before the conversion, as the reduction 
+         * only vectorises when evaluated in double precision on its own.
+         *
+         * @param phase Phases in radians, in double precision. Overwritten by the reduced phases if Real is not double.
+         * @param result Phases in radians as an array of Real, of the size of phase.
+         */
+        template<typename Derived, typename Result>
+        void reduce_phase(Eigen::ArrayBase<Derived>& phase, const Eigen::ArrayBase<Result>& result) {
+            using Real = typename Result::Scalar;
+            if constexpr (!std::is_same_v<Real, double>) {
+                Fast::normalise_angle_PI(phase, phase);
+            }
+            result.const_cast_derived() = phase.template cast<Real>();
+        }
+
+    }
+
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+#include "geometry.h"
+#include "sea_surface.h"
+#include "asv.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+
+namespace ASVLite {
+
+    /**
+     * @brief Action of the agent in each environment of a VecEnv.
+     */
+    enum class ActionType {
+        /** @brief Rudder angle in radians, one value per environment. Positive turns to starboard. The thrust
+         *         is that of a wave glider (see get_wave_glider_thrust()). */
+        RUDDER_ANGLE,
+        /** @brief Thrust in surge, sway and heave in the body-fixed frame in Newtons, three values per environment,
+         *         applied at the stern. */
+        THRUST
+    };
+
+
+    /**
+     * @brief Reason an episode ended, written to the done flags of VecEnv::step().
+     */
+    enum EpisodeEnd : uint8_t {
+        /** @brief The episode continues. */
+        NOT_DONE = 0,
+        /** @brief The vehicle reached the waypoint (terminated). */
+        ARRIVED = 1,
+        /** @brief The episode reached its duration (truncated). */
+        TIME_LIMIT = 2
+    };
+
+
+
+    /**
+     * @brief Vectorised reinforcement learning environment of K vehicles steering to waypoints.
+     *
+     * Each environment is an Asv on a sea surface shared by all environments, with its own start pose, waypoint and
+     * clock. One call of step() applies an action to every environment, advances each by one action interval (a whole
+     * number of time steps), and writes the observations, rewards and done flags to buffers owned by the caller, so a
+     * trainer, or the Python wrapper over NumPy arrays, exchanges K environments per call with no per-vehicle calls
+     * and no copies. All buffers are contiguous and row-major, with one row per environment.
+     *
+     * Observation of an environment, COUNT_OBSERVATIONS values:
+     *  - 0, 1: offset of the waypoint from the vehicle, east and north (m),
+     *  - 2: bearing of the waypoint relative to the heading, positive to starboard (radian, [-PI, PI]),
+     *  - 3, 4, 5: roll, pitch and yaw w.r.t. geographic north (radian),
+     *  - 6 to 11: velocity in surge, sway, heave (m/s), roll, pitch and yaw (radian/s) in the body-fixed frame.
+     *
+     * The reward is the reduction of the horizontal distance to the waypoint over the action interval (m). An episode
+     * ends when the vehicle comes within the arrival radius of the waypoint or when the episode duration has elapsed.
+     * An environment whose episode ended is reset in the same call to the snapshot of its start (see AsvState),
+     * without reconstructing the vehicle, and the observation written for it is that of the new episode.
+     *
+     * @tparam N, Trig, Real, Structure, Integrator The template parameters of the vehicles (see Asv).
+     */
+    template<size_t N, typename Trig = Trigonometry::Exact, typename Real = double, typename Structure = MatrixStructure::Diagonal,
+             typename Integrator = Integration::SemiImplicitEuler>
+    class VecEnv {
+
+        public:
+
+            /** @brief Number of values in the observation of an environment. */
+            static constexpr size_t COUNT_OBSERVATIONS = 12;
+
+            /** @brief Largest rudder angle, to which the rudder actions are clipped (radian). */
+            static constexpr double MAX_RUDDER_ANGLE = M_PI / 6.0;
+
+
+            /**
+             * @brief Constructs K environments, one for each start pose and waypoint, and resets them.
+             *
+             * @param spec ASV geometric specifications, shared by all environments.
+             * @param sea_surface Pointer to the sea surface shared by all environments (must not be nullptr).
+             * @param start_positions Start position of each environment (in meters). The vertical position is set on the sea surface.
+             * @param start_attitudes Start attitude of each environment (roll, pitch, yaw in radians, yaw is w.r.t. geographic north).
+             * @param waypoints Waypoint of each environment (in meters).
+             * @param action_type Type of action (see ActionType).
+             * @param action_interval Time for which an action is applied, in milliseconds. A whole multiple of the time step of 40 ms.
+             * @param episode_duration Longest duration of an episode in seconds (must be positive).
+             * @param arrival_radius Horizontal distance to the waypoint at which an episode ends (in meters, must be positive).
+             *
+             * @throws std::invalid_argument if sea_surface is a nullptr, if there are no environments, if the start positions,
+             *         start attitudes and waypoints differ in number, if the action interval is not a positive multiple
+             *         of the time step, or if the episode duration or the arrival radius is not positive.
+             */
+            VecEnv(const AsvSpecification& spec,
+                   const SeaSurface<N, Trig, Real>* sea_surface,
+                   const std::vector<Geometry::Coordinates3D>& start_positions,
+                   const std::vector<Geometry::Coordinates3D>& start_attitudes,
+                   const std::vector<Geometry::Coordinates3D>& waypoints,
+                   const ActionType action_type = ActionType::RUDDER_ANGLE,
+                   const double action_interval = 1000.0,
+                   const double episode_duration = 600.0,
+                   const double arrival_radius = 5.0) :
+            action_type {action_type},
+            count_actions {action_type == ActionType::RUDDER_ANGLE ? size_t(1) : size_t(3)},
+            episode_duration {episode_duration},
+            arrival_radius {arrival_radius},
+            waypoints {waypoints} {
+                if(sea_surface == nullptr) {
+                    throw std::invalid_argument("Sea surface cannot be nullptr.");
+                }
+                if(start_positions.empty()) {
+                    throw std::invalid_argument("There must be at least one environment.");
+                }
+                if(start_attitudes.size() != start_positions.size() or waypoints.size() != start_positions.size()) {
+                    throw std::invalid_argument("Start positions, start attitudes and waypoints must be of the same number.");
+                }
+                if(episode_duration <= 0.0) {
+                    throw std::invalid_argument("Episode duration must be positive.");
+                }
+                if(arrival_radius <= 0.0) {
+                    throw std::invalid_argument("Arrival radius must be positive.");
+                }
+                vehicles.reserve(start_positions.size());
+                for(size_t k = 0; k < start_positions.size(); ++k) {
+                    vehicles.emplace_back(spec, sea_surface, start_positions[k], start_attitudes[k]);
+                }
+                const double time_step_size = vehicles.front().get_time_step_size();
+                const double count_steps = std::round(action_interval / time_step_size);
+                if(count_steps < 1.0 or std::abs(count_steps * time_step_size - action_interval) > 1e-9 * action_interval) {
+                    throw std::invalid_argument("Action interval must be a positive multiple of the time step size.");
+                }
+                count_steps_per_action = static_cast<size_t>(count_steps);
+                start_states.reserve(vehicles.size());
+                for(const auto& vehicle : vehicles) {
+                    start_states.push_back(vehicle.save_state());
+                }
+                distances.resize(vehicles.size());
+                for(size_t k = 0; k < vehicles.size(); ++k) {
+                    distances[k] = get_distance(k);
+                }
+            }
+
+
+            /**
+             * @brief Resets every environment to its start and writes the observations.
+             *
+             * @param observations Buffer of K × COUNT_OBSERVATIONS values.
+             */
+            void reset(double* observations) {
+                for(size_t k = 0; k < vehicles.size(); ++k) {
+                    reset(k);
+                    set_observation(k, observations + k * COUNT_OBSERVATIONS);
+                }
+            }
+
+
+            /**
+             * @brief Applies an action to every environment for one action interval.
+             *
+             * Environments whose episode ended are reset, and their observation is that of the new episode.
+             *
+             * @param actions Buffer of K × get_count_actions() values (see ActionType).
+             * @param observations Buffer of K × COUNT_OBSERVATIONS values, for the observations after the step.
+             * @param rewards Buffer of K values, for the rewards of the step.
+             * @param dones Buffer of K values, for the done flags of the step (see EpisodeEnd).
+             * @param terminal_observations Optional buffer of K × COUNT_OBSERVATIONS values. For an environment whose
+             *        episode ended, the last observation of the episode is written to its row, e.g. to bootstrap the
+             *        value of a truncated episode; other rows are left unchanged.
+             */
+            void step(const double* actions, double* observations, double* rewards, uint8_t* dones, double* terminal_observations = nullptr) {
+                for(size_t k = 0; k < vehicles.size(); ++k) {
+                    const double* action = actions + k * count_actions;
+                    double* observation = observations + k * COUNT_OBSERVATIONS;
+                    step(k, action);
+                    const double distance = get_distance(k);
+                    rewards[k] = distances[k] - distance;
+                    distances[k] = distance;
+                    dones[k] = (distance <= arrival_radius) ? ARRIVED :
+                               (vehicles[k].get_time() >= start_states[k].dynamics.time + episode_duration - 1e-9) ? TIME_LIMIT : NOT_DONE;
+                    if(dones[k] != NOT_DONE) {
+                        if(terminal_observations != nullptr) {
+                            set_observation(k, terminal_observations + k * COUNT_OBSERVATIONS);
+                        }
+                        reset(k);
+                    }
+                    set_observation(k, observation);
+                }
+            }
+
+
+            /**
+             * @brief Sets the start pose and the waypoint of an environment, from its next episode.
+             *
+             * @param k Index of the environment.
+             * @param position Start position (in meters). The vertical position is set on the sea surface.
+             * @param attitude Start attitude (roll, pitch, yaw in radians, yaw is w.r.t. geographic north).
+             * @param waypoint Waypoint (in meters).
+             *
+             * @throws std::out_of_range if k is not the index of an environment.
+             */
+            void set_start(const size_t k, const Geometry::Coordinates3D& position, const Geometry::Coordinates3D& attitude,
+                           const Geometry::Coordinates3D& waypoint) {
+                const Asv<N, Trig, Real, Structure, Integrator>& current = get_vehicle(k);
+                const Asv<N, Trig, Real, Structure, Integrator> vehicle {current.get_spec(), current.get_sea_surface(), position, attitude};
+                start_states[k] = vehicle.save_state();
+                waypoints[k] = waypoint;
+            }
+
+
+            /**
+             * @brief Returns the number of environments.
+             */
+            size_t get_count_environments() const {
+                return vehicles.size();
+            }
+
+
+            /**
+             * @brief Returns the number of values in the action of an environment.
+             */
+            size_t get_count_actions() const {
+                return count_actions;
+            }
+
+
+            /**
+             * @brief Returns the number of time steps in an action interval.
+             */
+            size_t get_count_steps_per_action() const {
+                return count_steps_per_action;
+            }
+
+
+            /**
+             * @brief Returns the vehicle of an environment.
+             *
+             * @throws std::out_of_range if k is not the index of an environment.
+             */
+            const Asv<N, Trig, Real, Structure, Integrator>& get_vehicle(const size_t k) const {
+                if(k >= vehicles.size()) {
+                    throw std::out_of_range("Environment index out of range.");
+                }
+                return vehicles[k];
+            }
+
+
+            /** @brief Type of action. */
+            const ActionType action_type;
+
+            /** @brief Number of values in the action of an environment. */
+            const size_t count_actions;
+
+            /** @brief Longest duration of an episode (in seconds). */
+            const double episode_duration;
+
+            /** @brief Horizontal distance to the waypoint at which an episode ends (in meters). */
+            const double arrival_radius;
+
+
+        private:
+
+            /**
+             * @brief Returns an environment to the start of its episode.
+             */
+            void reset(const size_t k) {
+                vehicles[k].restore_state(start_states[k]);
+                distances[k] = get_distance(k);
+            }
+
+
+            /**
+             * @brief Applies an action to an environment for one action interval.
+             */
+            void step(const size_t k, const double* action) {
+                auto& vehicle = vehicles[k];
+                if(action_type == ActionType::RUDDER_ANGLE) {
+                    const double rudder_angle = std::clamp(action[0], -MAX_RUDDER_ANGLE, MAX_RUDDER_ANGLE);
+                    const double significant_wave_height = vehicle.get_sea_surface()->significant_wave_height;
+                    for(size_t i = 0; i < count_steps_per_action; ++i) {
+                        // The thrust of the glider follows the heave motion, so it is updated every time step.
+                        const auto [thrust_position, thrust_magnitude] = get_wave_glider_thrust(vehicle, rudder_angle, significant_wave_height);
+                        vehicle.step_simulation(thrust_position, thrust_magnitude);
+                    }
+                } else {
+                    const Geometry::Coordinates3D thrust_position {-vehicle.get_spec().L_wl/2.0, 0.0, 0.0};
+                    const Geometry::Coordinates3D thrust_magnitude {action[0], action[1], action[2]};
+                    for(size_t i = 0; i < count_steps_per_action; ++i) {
+                        vehicle.step_simulation(thrust_position, thrust_magnitude);
+                    }
+                }
+            }
+
+
+            /**
+             * @brief Returns the horizontal distance from the vehicle of an environment to its waypoint (in meters).
+             */
+            double get_distance(const size_t k) const {
+                const Geometry::Coordinates3D position = vehicles[k].get_position();
+                return std::hypot(waypoints[k].keys.x - position.keys.x, waypoints[k].keys.y - position.keys.y);
+            }
+
+
+            /**
+             * @brief Writes the observation of an environment (see VecEnv) to COUNT_OBSERVATIONS values.
+             */
+            void set_observation(const size_t k, double* observation) const {
+                // Position, attitude with yaw counterclockwise from East, and velocity.
+                const Integration::State state = vehicles[k].get_state();
+                const double dx = waypoints[k].keys.x - state(0);
+                const double dy = waypoints[k].keys.y - state(1);
+                observation[0] = dx;
+                observation[1] = dy;
+                // Heading and bearing are both counterclockwise from East, so the difference is positive to starboard.
+                observation[2] = Geometry::normalise_angle_PI(state(5) - std::atan2(dy, dx));
+                observation[3] = state(3);
+                observation[4] = state(4);
+                observation[5] = Geometry::switch_angle_frame(state(5));
+                for(size_t i = 0; i < Geometry::COUNT_DOF; ++i) {
+                    observation[6 + i] = state(6 + i);
+                }
+            }
+
+
+            /** @brief Vehicle of each environment. */
+            std::vector<Asv<N, Trig, Real, Structure, Integrator>> vehicles;
+
+            /** @brief Snapshot of the start of the episode of each environment. */
+            std::vector<AsvState<N, Trig, Real, Structure, Integrator>> start_states;
+
+            /** @brief Waypoint of each environment. */
+            std::vector<Geometry::Coordinates3D> waypoints;
+
+            /** @brief Horizontal distance to the waypoint of each environment, after the last step (in meters). */
+            std::vector<double> distances;
+
+            /** @brief Number of time steps in an action interval. */
+            size_t count_steps_per_action;
+    };
+
+}
@@ -0,0 +1,104 @@
+#include "ASVLite/asv.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <ctime>
+#include <algorithm>
+#include <string>
+#include <cmath>
+
+using namespace ASVLite;
+
+// Accuracy against speed of the time integration schemes. Wave gliders are simulated for half an hour
+// at a range of time step sizes, and the positions every 2 s are compared with a reference run with
+// RK4 at 10 ms. The error is reported with the simulation speed in steps per second. The thrust is
+// held constant over a time step, so larger steps also update the thrust less often.
+
+constexpr size_t count_component_waves = 15;
+
+const AsvSpecification asv_spec {
+    .L_wl = 2.1, // m
+    .B_wl = 0.6, // m
+    .D = 0.25,   // m
+    .T = 0.15,   // m
+};
+
+const double sample_interval = 2.0; // sec
+
+/**
+ * @brief Position of a wave glider every sample_interval, and the cost of the simulation.
+ */
+struct Trajectory {
+    std::vector<Geometry::Coordinates3D> positions;
+    size_t count_steps;
+    double cpu_time; // sec
+};
+
+template<typename Integrator>
+Trajectory simulate(const double wave_ht, const double wave_dp, const double time_step_size, const double simulation_duration,
+                    const Integrator& integrator = Integrator()) {
+    const int wave_rand_seed = 1;
+    const double rudder_angle = 10.0 * M_PI/180.0; // rad
+    const SeaSurface<count_component_waves> sea_surface {wave_ht, wave_dp, wave_rand_seed};
+    const Geometry::Coordinates3D position {100.0, 100.0, 0.0};
+    const Geometry::Coordinates3D attitude {0, 0, 0};
+    Asv<count_component_waves, Trigonometry::Exact, double, MatrixStructure::Diagonal, Integrator> asv {asv_spec, &sea_surface, position, attitude, integrator};
+    asv.set_time_step_size(time_step_size);
+    const size_t steps_per_sample = std::lround(sample_interval * 1000.0 / time_step_size);
+    Trajectory trajectory {{}, 0, 0.0};
+    std::clock_t start = std::clock();
+    while(asv.get_time() < simulation_duration - 1e-9) {
+        auto [thrust_position, thrust_magnitude] = get_wave_glider_thrust(asv, rudder_angle, wave_ht);
+        asv.step_simulation(thrust_position, thrust_magnitude);
+        if(++trajectory.count_steps % steps_per_sample == 0) {
+            trajectory.positions.push_back(asv.get_position());
+        }
+    }
+    std::clock_t end = std::clock();
+    trajectory.cpu_time = double(end - start) / CLOCKS_PER_SEC;
+    return trajectory;
+}
+
+void report_error(const std::string& name, const double time_step_size, const Trajectory& reference, const Trajectory& trajectory) {
+    double max_horizontal_error = 0.0;
+    double max_heave_error = 0.0;
+    const size_t count_samples = std::min(reference.positions.size(), trajectory.positions.size());
+    for(size_t i = 0; i < count_samples; ++i) {
+        const Geometry::Coordinates3D& p_ref = reference.positions[i];
+        const Geometry::Coordinates3D& p = trajectory.positions[i];
+        max_horizontal_error = std::max(max_horizontal_error, std::hypot(p.keys.x - p_ref.keys.x, p.keys.y - p_ref.keys.y));
+        max_heave_error = std::max(max_heave_error, std::abs(p.keys.z - p_ref.keys.z));
+    }
+    std::cout << "  " << std::left << std::setw(22) << name << std::right
+              << " step " << std::setw(5) << time_step_size << " ms"
+              << ", max horizontal error " << std::setw(10) << max_horizontal_error << " m"
+              << ", max heave error " << std::setw(10) << max_heave_error << " m"
+              << ", " << std::setw(10) << trajectory.count_steps/trajectory.cpu_time << " steps/sec"
+              << ", " << std::setw(8) << trajectory.positions.size() * sample_interval/trajectory.cpu_time << " X realtime\n";
+}
+
+int main() {
+    const double simulation_duration = 30 * 60; // sec
+    const std::vector<double> wave_hts {1.0, 3.5, 7.5}; // m
+    const double wave_dp = M_PI/3.0; // rad
+
+    std::cout << std::setprecision(3);
+    for(const double wave_ht : wave_hts) {
+        std::cout << "Wave height " << wave_ht << " m:\n";
+        const Trajectory reference = simulate<Integration::RungeKutta4>(wave_ht, wave_dp, 10.0, simulation_duration);
+        for(const double time_step_size : {40.0, 100.0, 200.0}) {
+            report_error("semi-implicit Euler", time_step_size, reference, simulate<Integration::SemiImplicitEuler>(wave_ht, wave_dp, time_step_size, simulation_duration));
+        }
+        for(const double time_step_size : {40.0, 100.0, 200.0, 400.0}) {
+            report_error("RK4", time_step_size, reference, simulate<Integration::RungeKutta4>(wave_ht, wave_dp, time_step_size, simulation_duration));
+        }
+        for(const double tolerance : {1e-4, 1e-6}) {
+            const std::string name = "adaptive, tol " + std::to_string(tolerance).substr(0, 8);
+            for(const double time_step_size : {200.0, 400.0}) {
+                report_error(name, time_step_size, reference, simulate<Integration::Adaptive>(wave_ht, wave_dp, time_step_size, simulation_duration, Integration::Adaptive(tolerance)));
+            }
+        }
+    }
+
+    return 0;
+}
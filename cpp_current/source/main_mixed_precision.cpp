@@ -0,0 +1,128 @@
+#include "ASVLite/asv.h"
+#include "ASVLite/asv_batch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <ctime>
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <cmath>
+
+using namespace ASVLite;
+
+// Validation of the mixed precision mode. Wave gliders are simulated for an hour in a range of sea
+// states with the component waves and wave forces evaluated in double and in float, and the drift of
+// the float trajectories from the all-double trajectory is reported along with the simulation speed.
+
+constexpr size_t count_component_waves = 15;
+
+const AsvSpecification asv_spec {
+    .L_wl = 2.1, // m
+    .B_wl = 0.6, // m
+    .D = 0.25,   // m
+    .T = 0.15,   // m
+};
+
+/**
+ * @brief Position and attitude of a wave glider at every time step of a simulation.
+ */
+struct Trajectory {
+    std::vector<Geometry::Coordinates3D> positions;
+    std::vector<Geometry::Coordinates3D> attitudes;
+    double cpu_time; // sec
+};
+
+template<typename Trig, typename Real>
+Trajectory simulate(const double wave_ht, const double wave_dp, const double rudder_angle, const double simulation_duration) {
+    const int wave_rand_seed = 1;
+    const SeaSurface<count_component_waves, Trig, Real> sea_surface {wave_ht, wave_dp, wave_rand_seed};
+    const Geometry::Coordinates3D position {100.0, 100.0, 0.0};
+    const Geometry::Coordinates3D attitude {0, 0, 0};
+    Asv<count_component_waves, Trig, Real> asv {asv_spec, &sea_surface, position, attitude};
+    Trajectory trajectory;
+    std::clock_t start = std::clock();
+    while(asv.get_time() < simulation_duration) {
+        auto [thrust_position, thrust_magnitude] = get_wave_glider_thrust(asv, rudder_angle, wave_ht);
+        asv.step_simulation(thrust_position, thrust_magnitude);
+        trajectory.positions.push_back(asv.get_position());
+        trajectory.attitudes.push_back(asv.get_attitude());
+    }
+    std::clock_t end = std::clock();
+    trajectory.cpu_time = double(end - start) / CLOCKS_PER_SEC;
+    return trajectory;
+}
+
+void report_drift(const std::string& name, const Trajectory& reference, const Trajectory& trajectory, const double simulation_duration) {
+    double max_horizontal_drift = 0.0;
+    double max_heave_drift = 0.0;
+    double max_attitude_drift = 0.0;
+    for(size_t i = 0; i < reference.positions.size(); ++i) {
+        const Geometry::Coordinates3D& p_ref = reference.positions[i];
+        const Geometry::Coordinates3D& p = trajectory.positions[i];
+        max_horizontal_drift = std::max(max_horizontal_drift, std::hypot(p.keys.x - p_ref.keys.x, p.keys.y - p_ref.keys.y));
+        max_heave_drift = std::max(max_heave_drift, std::abs(p.keys.z - p_ref.keys.z));
+        for(size_t j = 0; j < Geometry::COUNT_COORDINATES; ++j) {
+            max_attitude_drift = std::max(max_attitude_drift, std::abs(Geometry::normalise_angle_PI(trajectory.attitudes[i].array[j] - reference.attitudes[i].array[j])));
+        }
+    }
+    const Geometry::Coordinates3D& p_ref = reference.positions.back();
+    const Geometry::Coordinates3D& p = trajectory.positions.back();
+    const double distance_travelled = std::hypot(p_ref.keys.x - 100.0, p_ref.keys.y - 100.0);
+    std::cout << "  " << std::left << std::setw(14) << name << std::right
+              << " final drift " << std::setw(10) << std::hypot(p.keys.x - p_ref.keys.x, p.keys.y - p_ref.keys.y) << " m"
+              << " (" << std::setw(10) << std::hypot(p.keys.x - p_ref.keys.x, p.keys.y - p_ref.keys.y)/distance_travelled << " of distance)"
+              << ", max drift " << std::setw(10) << max_horizontal_drift << " m"
+              << ", max heave drift " << std::setw(10) << max_heave_drift << " m"
+              << ", max attitude drift " << std::setw(10) << max_attitude_drift * 180.0/M_PI << " deg"
+              << ", speed " << std::setw(8) << simulation_duration/trajectory.cpu_time << " X realtime\n";
+}
+
+template<typename Trig, typename Real>
+double swarm_throughput(const size_t count_vehicles, const size_t count_steps) {
+    const SeaSurface<count_component_waves, Trig, Real> sea_surface {3.5, M_PI/3.0, 1};
+    AsvBatch<count_component_waves, Trig, Real> swarm {&sea_surface};
+    for(size_t k = 0; k < count_vehicles; ++k) {
+        swarm.add_vehicle(asv_spec, Geometry::Coordinates3D {10.0 * k, 5.0 * k, 0.0}, Geometry::Coordinates3D {0.0, 0.0, 0.0});
+    }
+    std::vector<Geometry::Coordinates3D> thrust_positions(count_vehicles);
+    std::vector<Geometry::Coordinates3D> thrust_magnitudes(count_vehicles);
+    std::clock_t start = std::clock();
+    for(size_t i = 0; i < count_steps; ++i) {
+        for(size_t k = 0; k < count_vehicles; ++k) {
+            std::tie(thrust_positions[k], thrust_magnitudes[k]) = get_wave_glider_thrust(asv_spec, swarm.get_velocity(k), 0.0, sea_surface.significant_wave_height);
+        }
+        swarm.step_simulation(thrust_positions, thrust_magnitudes);
+    }
+    std::clock_t end = std::clock();
+    return count_vehicles * count_steps / (double(end - start) / CLOCKS_PER_SEC); // vehicle steps per sec
+}
+
+int main() {
+    const double simulation_duration = 60 * 60; // sec
+    const std::vector<double> wave_hts {1.0, 3.5, 7.5}; // m
+    const std::vector<double> wave_dps {0.0, M_PI/3.0, M_PI}; // rad
+    const double rudder_angle = 10.0 * M_PI/180.0; // rad
+
+    std::cout << std::setprecision(3);
+    for(const double wave_ht : wave_hts) {
+        for(const double wave_dp : wave_dps) {
+            std::cout << "Wave height " << wave_ht << " m, wave heading " << wave_dp * 180.0/M_PI << " deg:\n";
+            const Trajectory reference = simulate<Trigonometry::Exact, double>(wave_ht, wave_dp, rudder_angle, simulation_duration);
+            report_drift("double", reference, reference, simulation_duration);
+            report_drift("float", reference, simulate<Trigonometry::Exact, float>(wave_ht, wave_dp, rudder_angle, simulation_duration), simulation_duration);
+            report_drift("double, fast", reference, simulate<Trigonometry::Fast, double>(wave_ht, wave_dp, rudder_angle, simulation_duration), simulation_duration);
+            report_drift("float, fast", reference, simulate<Trigonometry::Fast, float>(wave_ht, wave_dp, rudder_angle, simulation_duration), simulation_duration);
+        }
+    }
+
+    const size_t count_vehicles = 10000;
+    const size_t count_steps = 50;
+    std::cout << "Swarm of " << count_vehicles << " vehicles (vehicle steps per second):\n"
+              << "  double       " << swarm_throughput<Trigonometry::Exact, double>(count_vehicles, count_steps) << "\n"
+              << "  float        " << swarm_throughput<Trigonometry::Exact, float>(count_vehicles, count_steps) << "\n"
+              << "  double, fast " << swarm_throughput<Trigonometry::Fast, double>(count_vehicles, count_steps) << "\n"
+              << "  float, fast  " << swarm_throughput<Trigonometry::Fast, float>(count_vehicles, count_steps) << "\n";
+
+    return 0;
+}
@@ -6,6 +6,32 @@
 #include <ctime>
 #include <algorithm>
 
+#ifdef ASVLITE_ALLOCATION_CHECK
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations made through operator new. Allocations made by Eigen are trapped 
+// separately by EIGEN_RUNTIME_NO_MALLOC (asserts are active in non-release builds).
+static std::atomic<size_t> count_heap_allocations {0};
+
+void* operator new(std::size_t size) {
+    ++count_heap_allocations;
+    if(void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+
 using namespace ASVLite;
 
 int main() {
@@ -50,7 +76,18 @@ int main() {
         while(asv.get_time() < simulation_duration) {
             ++i;
             auto [thrust_position, thrust_magnitude] = get_wave_glider_thrust(asv, 0.0, sea_surface.significant_wave_height);
+#ifdef ASVLITE_ALLOCATION_CHECK
+            const size_t count_heap_allocations_before_step = count_heap_allocations;
+            Eigen::internal::set_is_malloc_allowed(false);
+#endif
             asv.step_simulation(thrust_position, thrust_magnitude);
+#ifdef ASVLITE_ALLOCATION_CHECK
+            Eigen::internal::set_is_malloc_allowed(true);
+            if(count_heap_allocations != count_heap_allocations_before_step) {
+                std::cerr << "Error: step_simulation allocated on the heap at step " << i << std::endl;
+                return 1;
+            }
+#endif
             
             // file<< asv.get_position().keys.x << "," 
             //     << asv.get_position().keys.y << "," 
@@ -0,0 +1,87 @@
+#include "ASVLite/swarm.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+
+using namespace ASVLite;
+
+// Scaling of Swarm with the number of threads. Swarms of 1k to 100k wave gliders, each steered by its own
+// controller callback, are stepped on 1 thread and on up to all hardware threads. The throughput in vehicle 
+// steps per second is reported with the speedup over 1 thread, and the final positions are checked to be the 
+// same for every number of threads.
+
+constexpr size_t count_component_waves = 15;
+
+const AsvSpecification asv_spec {
+    .L_wl = 2.1, // m
+    .B_wl = 0.6, // m
+    .D = 0.25,   // m
+    .T = 0.15,   // m
+};
+
+/**
+ * @brief Throughput of a swarm, and the positions of its vehicles at the end.
+ */
+struct Result {
+    double vehicle_steps_per_sec;
+    std::vector<Geometry::Coordinates3D> positions;
+};
+
+Result simulate(const SeaSurface<count_component_waves>& sea_surface, const size_t count_vehicles, const size_t count_steps, const size_t count_threads) {
+    Swarm<count_component_waves> swarm {&sea_surface, count_threads};
+    const size_t count_columns = static_cast<size_t>(std::sqrt(count_vehicles));
+    for(size_t k = 0; k < count_vehicles; ++k) {
+        const Geometry::Coordinates3D position {20.0 * (k % count_columns), 20.0 * (k / count_columns), 0.0};
+        const double rudder_angle = (k % 7 - 3.0) * M_PI/36.0; // rad
+        swarm.add_vehicle(asv_spec, position, Geometry::Coordinates3D {0.0, 0.0, 0.0}, 
+                          [rudder_angle, &sea_surface](const Swarm<count_component_waves>::Vehicle& vehicle) {
+                              return get_wave_glider_thrust(vehicle, rudder_angle, sea_surface.significant_wave_height);
+                          });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count_steps; ++i) {
+        swarm.step_simulation();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    Result result;
+    result.vehicle_steps_per_sec = count_vehicles * count_steps / std::chrono::duration<double>(end - start).count();
+    for(size_t k = 0; k < count_vehicles; ++k) {
+        result.positions.push_back(swarm.get_vehicle(k).get_position());
+    }
+    return result;
+}
+
+int main() {
+    const SeaSurface<count_component_waves> sea_surface {3.5, M_PI/3.0, 1};
+    const size_t max_count_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> thread_counts;
+    for(size_t count_threads = 1; count_threads < max_count_threads; count_threads *= 2) {
+        thread_counts.push_back(count_threads);
+    }
+    thread_counts.push_back(max_count_threads);
+
+    std::cout << std::setprecision(3);
+    for(const size_t count_vehicles : {1000, 10000, 100000}) {
+        const size_t count_steps = 2000000 / count_vehicles;
+        std::cout << "Swarm of " << count_vehicles << " vehicles, " << count_steps << " time steps:\n";
+        const Result reference = simulate(sea_surface, count_vehicles, count_steps, 1);
+        for(const size_t count_threads : thread_counts) {
+            const Result result = (count_threads == 1) ? reference : simulate(sea_surface, count_vehicles, count_steps, count_threads);
+            bool is_identical = true;
+            for(size_t k = 0; k < count_vehicles; ++k) {
+                is_identical = is_identical and (result.positions[k].keys.x == reference.positions[k].keys.x) 
+                                            and (result.positions[k].keys.y == reference.positions[k].keys.y);
+            }
+            std::cout << "  " << std::setw(3) << count_threads << " threads: " 
+                      << std::setw(10) << result.vehicle_steps_per_sec << " vehicle steps/sec"
+                      << ", speedup " << std::setw(6) << result.vehicle_steps_per_sec / reference.vehicle_steps_per_sec
+                      << ", positions " << (is_identical ? "identical" : "DIFFER") << "\n";
+        }
+    }
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "ASVLite/asv.h"
+#include "ASVLite/sea_surface_registry.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
@@ -40,6 +41,9 @@ int main() {
     double cumulative_tuning_factor = 0.0;
     // Process each line in the file
     int line_count = 0;
+    // The rows only span a few distinct wave heights, so their sea surfaces are generated once and shared.
+    const size_t count_component_waves = 15;
+    SeaSurfaceRegistry<count_component_waves> sea_surfaces {16};
     while (std::getline(data_file, line)) {
         line_count++;
         std::stringstream ss(line);
@@ -63,10 +67,9 @@ int main() {
             const double target_speed = std::stod(row[15]); // m/s
 
             // Initialise the sea surface
-            const size_t count_component_waves = 15;
             const double wave_dp = M_PI/3.0; // rad
             const int wave_rand_seed = 1;
-            const SeaSurface<count_component_waves> sea_surface {wave_ht, wave_dp, wave_rand_seed};
+            const std::shared_ptr<const SeaSurface<count_component_waves>> sea_surface = sea_surfaces.get_sea_surface(wave_ht, wave_dp, wave_rand_seed);
 
             // Set ASV spec
             AsvSpecification asv_spec {
@@ -86,7 +89,7 @@ int main() {
                 const double y1 = 500.0; // m
                 const Geometry::Coordinates3D position {x1, y1, 0.0};
                 const Geometry::Coordinates3D attitude {0, 0, 0};
-                Asv asv {asv_spec, &sea_surface, position, attitude};
+                Asv asv {asv_spec, sea_surface.get(), position, attitude};
 
                 // Run simulation
                 while(asv.get_time() < sim_duration) {
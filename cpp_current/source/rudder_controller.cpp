@@ -1,12 +1,14 @@
 #include "ASVLite/rudder_controller.h"
+#include "ASVLite/sea_surface_registry.h"
+#include "ASVLite/thread_pool.h"
 #include <iostream>
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <numeric>
 #include <filesystem>
 #include <fstream>
-#include <future>
-#include <thread>
+#include <random>
 
 
 ASVLite::RudderController::RudderController(const ASVLite::AsvSpecification& asv_spec, const Eigen::Vector3d& initial_K) :
@@ -70,16 +72,28 @@ double ASVLite::RudderController::get_rudder_angle( const double target_heading,
 }
 
 
-double ASVLite::RudderController::simulate_wave_glider(const double significant_wave_ht, const double target_heading, const double P, const double I, const double D) const {
+std::vector<std::pair<double, double>> ASVLite::RudderController::get_tuning_conditions() {
+    std::vector<std::pair<double, double>> tuning_conditions;
+    for (double significant_wave_ht = 1.0; significant_wave_ht < 10.0; significant_wave_ht += 2.0) {
+        for (double target_heading = 0.0; target_heading < 360.0; target_heading += 45.0) {
+            tuning_conditions.push_back({significant_wave_ht, target_heading * M_PI / 180});
+        }
+    }
+    return tuning_conditions;
+}
+
+
+double ASVLite::RudderController::simulate_wave_glider(const double significant_wave_ht, const double target_heading, const double P, const double I, const double D, const size_t count_component_waves) const {
     // Init waves
-    const size_t num_component_waves = 15;
     const int rng_seed = 1;
     const double predominant_wave_heading = 0.0;
-    const SeaSurface<num_component_waves> sea_surface {significant_wave_ht, predominant_wave_heading, rng_seed};
+    // The tuning jobs run concurrently over a handful of sea states, so they share the sea surfaces.
+    static SeaSurfaceRegistry<DYNAMIC> sea_surfaces {16};
+    const std::shared_ptr<const SeaSurface<DYNAMIC>> sea_surface = sea_surfaces.get_sea_surface(significant_wave_ht, predominant_wave_heading, rng_seed, count_component_waves);
     // Init ASV
     const Geometry::Coordinates3D start_position {100.0, 100.0, 0.0};
     const Geometry::Coordinates3D attitude {0.0, 0.0, 0.0};
-    Asv<num_component_waves> asv {asv_spec, &sea_surface, start_position, attitude};
+    Asv<DYNAMIC> asv {asv_spec, sea_surface.get(), start_position, attitude};
     // Init rudder controller
     RudderController rudder_controller {asv_spec, {P, I, D}};
     // Simulate
@@ -130,6 +144,8 @@ void ASVLite::RudderController::tune_controller_local_search(const double lower_
     double I_current = K(1);
     double D_current = K(2);
 
+    const std::vector<std::pair<double, double>> tuning_conditions = get_tuning_conditions();
+    ThreadPool thread_pool;
     const size_t num_iterations = 30;
     for (int n = 0; n < num_iterations; ++n) {
 
@@ -147,14 +163,12 @@ void ASVLite::RudderController::tune_controller_local_search(const double lower_
             double P = std::max(PID[0], 0.0);// Prevent -ve value
             double I = std::max(PID[1], 0.0);// Prevent -ve value
             double D = std::max(PID[2], 0.0);// Prevent -ve value
-            std::vector<std::future<double>> futures;
-            for (double significant_wave_ht = 1.0; significant_wave_ht < 10.0; significant_wave_ht += 2.0) {
-                for (double target_heading = 0.0; target_heading < 360.0; target_heading += 45.0) {
-                    futures.push_back(std::async(std::launch::async, &ASVLite::RudderController::simulate_wave_glider, this, significant_wave_ht, target_heading * M_PI / 180, P, I, D));
+            std::vector<double> results(tuning_conditions.size());
+            thread_pool.parallel_for(tuning_conditions.size(), 1, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    results[i] = simulate_wave_glider(tuning_conditions[i].first, tuning_conditions[i].second, P, I, D, count_tuning_component_waves);
                 }
-            }
-            std::vector<double> results;
-            for (auto& f : futures) results.push_back(f.get());
+            });
             double avg_cost = std::accumulate(results.begin(), results.end(), 0.0) / results.size();
             costs.push_back({P, I, D, avg_cost});
         }
@@ -202,17 +216,17 @@ void ASVLite::RudderController::tune_controller_exhaustive_search(const double l
         }
     }
 
+    const std::vector<std::pair<double, double>> tuning_conditions = get_tuning_conditions();
+    ThreadPool thread_pool;
     std::vector<std::vector<double>> costs;
     for (auto& PID : PIDs) {
         double P = PID[0], I = PID[1], D = PID[2];
-        std::vector<std::future<double>> futures;
-        for (double significant_wave_ht = 1.0; significant_wave_ht < 10.0; significant_wave_ht += 2.0) {
-            for (double target_heading = 0.0; target_heading < 360.0; target_heading += 45.0) {
-                futures.push_back(std::async(std::launch::async, &ASVLite::RudderController::simulate_wave_glider, this, significant_wave_ht, target_heading * M_PI / 180, P, I, D));
+        std::vector<double> results(tuning_conditions.size());
+        thread_pool.parallel_for(tuning_conditions.size(), 1, [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = simulate_wave_glider(tuning_conditions[i].first, tuning_conditions[i].second, P, I, D, count_tuning_component_waves);
             }
-        }
-        std::vector<double> results;
-        for (auto& f : futures) results.push_back(f.get());
+        });
         double avg_cost = std::accumulate(results.begin(), results.end(), 0.0) / results.size();
         costs.push_back({P, I, D, avg_cost});
         result_file << P << "," << I << "," << D << "," << avg_cost << "\n";
@@ -0,0 +1,70 @@
+#include "ASVLite/asv.h"
+#include "ASVLite/asv_batch.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using namespace ASVLite;
+
+// A vehicle in an AsvBatch follows the same equations as an Asv, so K wave gliders stepped in a batch should
+// reproduce the trajectories of K separate Asv with the same inputs to within floating point rounding. The
+// trajectories are compared at every step of a 200 s run, every step and with multi-rate wave force updates.
+
+constexpr size_t count_component_waves = 15;
+constexpr size_t count_vehicles = 8;
+constexpr size_t count_steps = 5000;
+
+const AsvSpecification asv_spec {
+    .L_wl = 2.1, // m
+    .B_wl = 0.6, // m
+    .D = 0.25,   // m
+    .T = 0.15,   // m
+};
+
+int main() {
+    const double wave_ht = 3.5; // m
+    const double max_position_error = 1e-9; // m
+    const double max_attitude_error = 1e-9; // rad
+    const SeaSurface<count_component_waves> sea_surface {wave_ht, M_PI/3.0, 1};
+    int count_failures = 0;
+    for(const double update_interval : {0.0, 80.0}) {
+        AsvBatch<count_component_waves> batch {&sea_surface};
+        std::vector<Asv<count_component_waves>> asvs;
+        std::vector<double> rudder_angles;
+        for(size_t k = 0; k < count_vehicles; ++k) {
+            const Geometry::Coordinates3D position {100.0 + 25.0 * k, 100.0 - 10.0 * k, 0.0};
+            const Geometry::Coordinates3D attitude {0.0, 0.0, k * M_PI/4.0};
+            batch.add_vehicle(asv_spec, position, attitude);
+            asvs.emplace_back(asv_spec, &sea_surface, position, attitude);
+            asvs.back().set_wave_force_update_interval(update_interval);
+            rudder_angles.push_back((static_cast<double>(k) - 4.0) * 5.0 * M_PI/180.0);
+        }
+        batch.set_wave_force_update_interval(update_interval);
+        std::vector<Geometry::Coordinates3D> thrust_positions(count_vehicles);
+        std::vector<Geometry::Coordinates3D> thrust_magnitudes(count_vehicles);
+        double position_error = 0.0;
+        double attitude_error = 0.0;
+        for(size_t i = 0; i < count_steps; ++i) {
+            for(size_t k = 0; k < count_vehicles; ++k) {
+                std::tie(thrust_positions[k], thrust_magnitudes[k]) = get_wave_glider_thrust(asv_spec, batch.get_velocity(k), rudder_angles[k], wave_ht);
+                auto [thrust_position, thrust_magnitude] = get_wave_glider_thrust(asvs[k], rudder_angles[k], wave_ht);
+                asvs[k].step_simulation(thrust_position, thrust_magnitude);
+            }
+            batch.step_simulation(thrust_positions, thrust_magnitudes);
+            for(size_t k = 0; k < count_vehicles; ++k) {
+                for(size_t j = 0; j < Geometry::COUNT_COORDINATES; ++j) {
+                    position_error = std::max(position_error, std::abs(batch.get_position(k).array[j] - asvs[k].get_position().array[j]));
+                    attitude_error = std::max(attitude_error, std::abs(Geometry::normalise_angle_PI(batch.get_attitude(k).array[j] - asvs[k].get_attitude().array[j])));
+                }
+            }
+        }
+        std::cout << "Update interval " << update_interval << " ms: position error " << position_error 
+                  << " m, attitude error " << attitude_error << " rad.\n";
+        if(position_error > max_position_error or attitude_error > max_attitude_error) {
+            std::cerr << "Batch trajectories differ from those of the single vehicles.\n";
+            ++count_failures;
+        }
+    }
+    return count_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+#include "ASVLite/sea_state_timeline.h"
+#include <iostream>
+
+using namespace ASVLite;
+
+// The component frequencies of a timeline are shared by all keyframes, so they must resolve the spectrum of each
+// keyframe, whether the sea builds or decays. The significant wave height implied by the component energies,
+// 4 sqrt(sum amplitude²/2), should match that of the keyframe.
+int main() {
+    const std::vector<std::vector<SeaStateKeyframe>> timelines {
+        {{0.0, 4.0, 0.0}, {1800.0, 1.0, 0.5}},
+        {{0.0, 3.0, 0.0}, {1800.0, 1.0, 0.5}},
+        {{0.0, 1.0, 0.0}, {1800.0, 4.0, 0.5}},
+        {{0.0, 2.0, 0.0}, {900.0, 3.0, 0.0, 9.0}, {1800.0, 0.5, 1.0}}
+    };
+    int count_failures = 0;
+    for(const std::vector<SeaStateKeyframe>& keyframes : timelines) {
+        SeaStateTimeline<DYNAMIC> timeline {keyframes, 7, 15};
+        for(const SeaStateKeyframe& keyframe : keyframes) {
+            timeline.set_time(keyframe.time);
+            const double variance = timeline.get_sea_surface()->component_waves.amplitude.squaredNorm() / 2.0;
+            const double significant_wave_height = 4.0 * std::sqrt(variance);
+            std::cout << "t = " << keyframe.time << " s: significant wave height " << significant_wave_height 
+                      << " m, keyframe " << keyframe.significant_wave_height << " m.\n";
+            if(std::abs(significant_wave_height / keyframe.significant_wave_height - 1.0) > 0.02) {
+                std::cerr << "Component energies do not match the keyframe.\n";
+                ++count_failures;
+            }
+            if(timeline.get_sea_surface()->significant_wave_height != keyframe.significant_wave_height) {
+                std::cerr << "Sea surface significant wave height does not follow the time.\n";
+                ++count_failures;
+            }
+        }
+    }
+    return count_failures == 0 ? 0 : 1;
+}
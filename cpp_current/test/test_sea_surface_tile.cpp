@@ -0,0 +1,26 @@
+#include "ASVLite/sea_surface_tile.h"
+#include <iostream>
+
+using namespace ASVLite;
+
+// The bins of a tile carry independent random phases, so the elevation field is Gaussian and its extremes
+// stay within a few standard deviations. Coherent phases focus the field into a spike at the origin. The
+// standard deviation of the field is the RMS elevation of the spectrum, Hs/4.
+int main() {
+    const SeaSurface<DYNAMIC> sea_surface {2.0, 0.3, 7, 21};
+    const SeaSurfaceTile tile {sea_surface, 1024.0, 256};
+    const Eigen::ArrayXXd& elevation = tile.get_elevation_field();
+    const double sigma = std::sqrt(elevation.square().mean());
+    const double max_elevation = elevation.abs().maxCoeff();
+    std::cout << "RMS elevation " << sigma << " m, max |elevation| " << max_elevation << " m at t = 0.\n";
+    if(not (sigma > 0.0 and max_elevation < 6.0 * sigma)) {
+        std::cerr << "Elevation field of the tile is not Gaussian: max |elevation| exceeds 6 standard deviations.\n";
+        return 1;
+    }
+    const double expected_sigma = sea_surface.significant_wave_height / 4.0;
+    if(std::abs(sigma / expected_sigma - 1.0) > 0.1) {
+        std::cerr << "RMS elevation of the tile differs from Hs/4 = " << expected_sigma << " m by more than 10%.\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "ASVLite/asv.h"
+#include "ASVLite/asv_batch.h"
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace ASVLite;
+
+// A simulation step should not allocate on the heap, whatever the policies of the vehicle, and neither should a
+// step of a batch of vehicles once the vehicles are added. Allocations made
+// through operator new are counted, and those made by Eigen are trapped by EIGEN_RUNTIME_NO_MALLOC, which is
+// defined for this test.
+
+static std::atomic<size_t> count_heap_allocations {0};
+
+void* operator new(std::size_t size) {
+    ++count_heap_allocations;
+    if(void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+constexpr size_t count_component_waves = 15;
+constexpr size_t count_steps = 500;
+
+const AsvSpecification asv_spec {
+    .L_wl = 2.1, // m
+    .B_wl = 0.6, // m
+    .D = 0.25,   // m
+    .T = 0.15,   // m
+};
+
+// Returns the number of heap allocations made by count_steps steps of a wave glider.
+template<size_t N, typename Trig, typename Real, typename Structure, typename Integrator>
+size_t count_step_allocations(const SeaSurface<N, Trig, Real>& sea_surface, const double update_interval) {
+    Asv<N, Trig, Real, Structure, Integrator> asv {asv_spec, &sea_surface, Geometry::Coordinates3D {100.0, 100.0, 0.0}, Geometry::Coordinates3D {0.0, 0.0, 0.0}};
+    asv.set_wave_force_update_interval(update_interval);
+    size_t count_allocations = 0;
+    for(size_t i = 0; i < count_steps; ++i) {
+        auto [thrust_position, thrust_magnitude] = get_wave_glider_thrust(asv, 10.0 * M_PI/180.0, sea_surface.significant_wave_height);
+        const size_t count_heap_allocations_before_step = count_heap_allocations;
+        Eigen::internal::set_is_malloc_allowed(false);
+        asv.step_simulation(thrust_position, thrust_magnitude);
+        Eigen::internal::set_is_malloc_allowed(true);
+        count_allocations += count_heap_allocations - count_heap_allocations_before_step;
+    }
+    return count_allocations;
+}
+
+// Returns the number of heap allocations made by count_steps steps of a batch of wave gliders.
+template<size_t N, typename Trig, typename Real>
+size_t count_batch_step_allocations(const SeaSurface<N, Trig, Real>& sea_surface, const double update_interval) {
+    constexpr size_t count_vehicles = 8;
+    AsvBatch<N, Trig, Real> batch {&sea_surface};
+    for(size_t k = 0; k < count_vehicles; ++k) {
+        batch.add_vehicle(asv_spec, Geometry::Coordinates3D {100.0 + 10.0 * k, 100.0, 0.0}, Geometry::Coordinates3D {0.0, 0.0, 0.0});
+    }
+    batch.set_wave_force_update_interval(update_interval);
+    std::vector<Geometry::Coordinates3D> thrust_positions(count_vehicles);
+    std::vector<Geometry::Coordinates3D> thrust_magnitudes(count_vehicles);
+    size_t count_allocations = 0;
+    for(size_t i = 0; i < count_steps; ++i) {
+        for(size_t k = 0; k < count_vehicles; ++k) {
+            std::tie(thrust_positions[k], thrust_magnitudes[k]) = get_wave_glider_thrust(asv_spec, batch.get_velocity(k), 10.0 * M_PI/180.0, sea_surface.significant_wave_height);
+        }
+        const size_t count_heap_allocations_before_step = count_heap_allocations;
+        Eigen::internal::set_is_malloc_allowed(false);
+        batch.step_simulation(thrust_positions, thrust_magnitudes);
+        Eigen::internal::set_is_malloc_allowed(true);
+        count_allocations += count_heap_allocations - count_heap_allocations_before_step;
+    }
+    return count_allocations;
+}
+
+int main() {
+    const double wave_ht = 3.5; // m
+    const double wave_dp = M_PI/3.0; // rad
+    const SeaSurface<count_component_waves> sea_surface {wave_ht, wave_dp, 1};
+    const SeaSurface<count_component_waves, Trigonometry::Fast, float> fast_sea_surface {wave_ht, wave_dp, 1};
+    const SeaSurface<DYNAMIC> dynamic_sea_surface {wave_ht, wave_dp, 1, count_component_waves};
+
+    using Exact = Trigonometry::Exact;
+    using Fast = Trigonometry::Fast;
+    using Diagonal = MatrixStructure::Diagonal;
+    using Coupled = MatrixStructure::Coupled;
+    using Euler = Integration::SemiImplicitEuler;
+    using RK4 = Integration::RungeKutta4;
+    using Adaptive = Integration::Adaptive;
+
+    const std::vector<std::pair<std::string, size_t>> results {
+        {"Euler", count_step_allocations<count_component_waves, Exact, double, Diagonal, Euler>(sea_surface, 0.0)},
+        {"RK4", count_step_allocations<count_component_waves, Exact, double, Diagonal, RK4>(sea_surface, 0.0)},
+        {"Adaptive", count_step_allocations<count_component_waves, Exact, double, Diagonal, Adaptive>(sea_surface, 0.0)},
+        {"Coupled", count_step_allocations<count_component_waves, Exact, double, Coupled, Euler>(sea_surface, 0.0)},
+        {"Coupled RK4", count_step_allocations<count_component_waves, Exact, double, Coupled, RK4>(sea_surface, 0.0)},
+        {"Multi-rate", count_step_allocations<count_component_waves, Exact, double, Diagonal, Euler>(sea_surface, 80.0)},
+        {"Multi-rate RK4", count_step_allocations<count_component_waves, Exact, double, Diagonal, RK4>(sea_surface, 80.0)},
+        {"Fast float", count_step_allocations<count_component_waves, Fast, float, Diagonal, Euler>(fast_sea_surface, 0.0)},
+        {"DYNAMIC", count_step_allocations<DYNAMIC, Exact, double, Diagonal, Euler>(dynamic_sea_surface, 0.0)},
+        {"DYNAMIC multi-rate", count_step_allocations<DYNAMIC, Exact, double, Diagonal, Euler>(dynamic_sea_surface, 80.0)},
+        {"Batch", count_batch_step_allocations<count_component_waves, Exact, double>(sea_surface, 0.0)},
+        {"Batch multi-rate", count_batch_step_allocations<count_component_waves, Exact, double>(sea_surface, 80.0)},
+        {"Batch Fast float", count_batch_step_allocations<count_component_waves, Fast, float>(fast_sea_surface, 0.0)},
+        {"Batch DYNAMIC", count_batch_step_allocations<DYNAMIC, Exact, double>(dynamic_sea_surface, 0.0)},
+    };
+
+    int count_failures = 0;
+    for(const auto& [name, count_allocations] : results) {
+        std::cout << name << ": " << count_allocations << " heap allocations in " << count_steps << " steps.\n";
+        if(count_allocations != 0) {
+            std::cerr << "Simulation step allocated on the heap.\n";
+            ++count_failures;
+        }
+    }
+    return count_failures == 0 ? 0 : 1;
+}
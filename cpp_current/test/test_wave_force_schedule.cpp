@@ -0,0 +1,70 @@
+#include "ASVLite/asv.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using namespace ASVLite;
+
+// With the wave force and added mass updated every 80 ms over a 40 ms time step, the trajectory of a wave glider
+// should stay close to that computed every time step. Over 600 s the drift was measured at up to 0.04 m in
+// position and 0.18° in attitude; the test allows 0.1 m and 0.5°. Over longer runs the trajectories diverge
+// further, as they do for any perturbation of the motion.
+
+constexpr size_t count_component_waves = 15;
+
+const AsvSpecification asv_spec {
+    .L_wl = 2.1, // m
+    .B_wl = 0.6, // m
+    .D = 0.25,   // m
+    .T = 0.15,   // m
+};
+
+struct Trajectory {
+    std::vector<Geometry::Coordinates3D> positions;
+    std::vector<Geometry::Coordinates3D> attitudes;
+};
+
+Trajectory simulate(const double wave_ht, const double wave_dp, const double update_interval, const double simulation_duration) {
+    const double rudder_angle = 10.0 * M_PI/180.0; // rad
+    const SeaSurface<count_component_waves> sea_surface {wave_ht, wave_dp, 1};
+    Asv<count_component_waves> asv {asv_spec, &sea_surface, Geometry::Coordinates3D {100.0, 100.0, 0.0}, Geometry::Coordinates3D {0.0, 0.0, 0.0}};
+    asv.set_wave_force_update_interval(update_interval);
+    Trajectory trajectory;
+    while(asv.get_time() < simulation_duration) {
+        auto [thrust_position, thrust_magnitude] = get_wave_glider_thrust(asv, rudder_angle, wave_ht);
+        asv.step_simulation(thrust_position, thrust_magnitude);
+        trajectory.positions.push_back(asv.get_position());
+        trajectory.attitudes.push_back(asv.get_attitude());
+    }
+    return trajectory;
+}
+
+int main() {
+    const double simulation_duration = 600.0; // sec
+    const double update_interval = 80.0; // ms
+    const double max_position_error = 0.1; // m
+    const double max_attitude_error = 0.5 * M_PI/180.0; // rad
+    int count_failures = 0;
+    for(const double wave_ht : {1.0, 3.5, 7.5}) {
+        for(const double wave_dp : {0.0, M_PI/3.0, M_PI}) {
+            const Trajectory reference = simulate(wave_ht, wave_dp, 0.0, simulation_duration);
+            const Trajectory trajectory = simulate(wave_ht, wave_dp, update_interval, simulation_duration);
+            double position_error = 0.0;
+            double attitude_error = 0.0;
+            for(size_t i = 0; i < reference.positions.size(); ++i) {
+                for(size_t j = 0; j < Geometry::COUNT_COORDINATES; ++j) {
+                    position_error = std::max(position_error, std::abs(trajectory.positions[i].array[j] - reference.positions[i].array[j]));
+                    attitude_error = std::max(attitude_error, std::abs(Geometry::normalise_angle_PI(trajectory.attitudes[i].array[j] - reference.attitudes[i].array[j])));
+                }
+            }
+            std::cout << "Wave height " << wave_ht << " m, wave heading " << wave_dp * 180.0/M_PI << " deg: position error " 
+                      << position_error << " m, attitude error " << attitude_error * 180.0/M_PI << " deg.\n";
+            if(position_error > max_position_error or attitude_error > max_attitude_error) {
+                std::cerr << "Multi-rate trajectory drifted beyond the bound.\n";
+                ++count_failures;
+            }
+        }
+    }
+    return count_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include "ASVLite/vec_env.h"
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ASVLite;
+
+// C interface to VecEnv<DYNAMIC> for the ctypes wrapper in vec_env.py. All arrays are contiguous and row-major,
+// and are read or written in place. The functions do not throw: a failed call returns nullptr or does nothing,
+// and vec_env_get_error_msg() returns the reason.
+
+namespace {
+
+    /**
+     * @brief Sea surface and the environments on it.
+     */
+    struct VecEnvHandle {
+        std::unique_ptr<const SeaSurface<DYNAMIC>> sea_surface;
+        std::unique_ptr<VecEnv<DYNAMIC>> vec_env;
+    };
+
+    /** @brief Message of the last failed call on this thread, empty if the last call succeeded. */
+    thread_local std::string error_msg;
+
+    std::vector<Geometry::Coordinates3D> get_coordinates(const double* array, const size_t count) {
+        std::vector<Geometry::Coordinates3D> coordinates(count);
+        for(size_t k = 0; k < count; ++k) {
+            coordinates[k] = Geometry::Coordinates3D {array[3*k], array[3*k + 1], array[3*k + 2]};
+        }
+        return coordinates;
+    }
+
+}
+
+extern "C" {
+
+    /**
+     * @brief Creates a sea surface and count_envs environments on it (see VecEnv::VecEnv()).
+     *
+     * @param start_positions, start_attitudes, waypoints Arrays of count_envs × 3 values.
+     * @param action_type 0 for ActionType::RUDDER_ANGLE, 1 for ActionType::THRUST.
+     * @return Handle to the environments, or nullptr on failure.
+     */
+    void* vec_env_new(const double L_wl, const double B_wl, const double D, const double T,
+                      const double sig_wave_height, const double wave_heading, const int rand_seed, const size_t count_component_waves,
+                      const size_t count_envs, const double* start_positions, const double* start_attitudes, const double* waypoints,
+                      const int action_type, const double action_interval, const double episode_duration, const double arrival_radius) {
+        try {
+            error_msg.clear();
+            auto handle = std::make_unique<VecEnvHandle>();
+            handle->sea_surface = std::make_unique<const SeaSurface<DYNAMIC>>(sig_wave_height, wave_heading, rand_seed, count_component_waves);
+            const AsvSpecification spec {L_wl, B_wl, D, T};
+            handle->vec_env = std::make_unique<VecEnv<DYNAMIC>>(spec, handle->sea_surface.get(),
+                                                                get_coordinates(start_positions, count_envs),
+                                                                get_coordinates(start_attitudes, count_envs),
+                                                                get_coordinates(waypoints, count_envs),
+                                                                action_type == 0 ? ActionType::RUDDER_ANGLE : ActionType::THRUST,
+                                                                action_interval, episode_duration, arrival_radius);
+            return handle.release();
+        } catch(const std::exception& e) {
+            error_msg = e.what();
+            return nullptr;
+        }
+    }
+
+    void vec_env_delete(void* handle) {
+        delete static_cast<VecEnvHandle*>(handle);
+    }
+
+    /**
+     * @brief Returns the message of the last failed call on this thread, or nullptr if the last call succeeded.
+     */
+    const char* vec_env_get_error_msg() {
+        return error_msg.empty() ? nullptr : error_msg.c_str();
+    }
+
+    size_t vec_env_get_count_environments(const void* handle) {
+        return static_cast<const VecEnvHandle*>(handle)->vec_env->get_count_environments();
+    }
+
+    size_t vec_env_get_count_actions(const void* handle) {
+        return static_cast<const VecEnvHandle*>(handle)->vec_env->get_count_actions();
+    }
+
+    size_t vec_env_get_count_observations() {
+        return VecEnv<DYNAMIC>::COUNT_OBSERVATIONS;
+    }
+
+    /**
+     * @brief Resets every environment to its start (see VecEnv::reset()).
+     *
+     * @param observations Array of count_envs × COUNT_OBSERVATIONS values.
+     */
+    void vec_env_reset(void* handle, double* observations) {
+        try {
+            error_msg.clear();
+            static_cast<VecEnvHandle*>(handle)->vec_env->reset(observations);
+        } catch(const std::exception& e) {
+            error_msg = e.what();
+        }
+    }
+
+    /**
+     * @brief Steps the environments (see VecEnv::step()).
+     *
+     * @param terminal_observations Array of count_envs × COUNT_OBSERVATIONS values, or nullptr.
+     */
+    void vec_env_step(void* handle, const double* actions, double* observations, double* rewards, uint8_t* dones, double* terminal_observations) {
+        try {
+            error_msg.clear();
+            static_cast<VecEnvHandle*>(handle)->vec_env->step(actions, observations, rewards, dones, terminal_observations);
+        } catch(const std::exception& e) {
+            error_msg = e.what();
+        }
+    }
+
+    /**
+     * @brief Sets the start pose and the waypoint of an environment (see VecEnv::set_start()).
+     *
+     * @param position, attitude, waypoint Arrays of 3 values.
+     */
+    void vec_env_set_start(void* handle, const size_t k, const double* position, const double* attitude, const double* waypoint) {
+        try {
+            error_msg.clear();
+            static_cast<VecEnvHandle*>(handle)->vec_env->set_start(k, get_coordinates(position, 1).front(),
+                                                                   get_coordinates(attitude, 1).front(),
+                                                                   get_coordinates(waypoint, 1).front());
+        } catch(const std::exception& e) {
+            error_msg = e.what();
+        }
+    }
+
+}
@@ -0,0 +1,146 @@
+import ctypes
+import pathlib
+import numpy as np
+
+path = pathlib.Path(__file__).parent.resolve()
+dll = ctypes.cdll.LoadLibrary(str(path) + "/lib/libASVLite-python.so")
+
+c_double_p = ctypes.POINTER(ctypes.c_double)
+c_uint8_p = ctypes.POINTER(ctypes.c_uint8)
+
+dll.vec_env_new.restype = ctypes.c_void_p
+dll.vec_env_new.argtypes = [ctypes.c_double, ctypes.c_double, ctypes.c_double, ctypes.c_double,
+                            ctypes.c_double, ctypes.c_double, ctypes.c_int, ctypes.c_size_t,
+                            ctypes.c_size_t, c_double_p, c_double_p, c_double_p,
+                            ctypes.c_int, ctypes.c_double, ctypes.c_double, ctypes.c_double]
+dll.vec_env_delete.restype = None
+dll.vec_env_delete.argtypes = [ctypes.c_void_p]
+dll.vec_env_get_error_msg.restype = ctypes.c_char_p
+dll.vec_env_get_error_msg.argtypes = []
+dll.vec_env_get_count_environments.restype = ctypes.c_size_t
+dll.vec_env_get_count_environments.argtypes = [ctypes.c_void_p]
+dll.vec_env_get_count_actions.restype = ctypes.c_size_t
+dll.vec_env_get_count_actions.argtypes = [ctypes.c_void_p]
+dll.vec_env_get_count_observations.restype = ctypes.c_size_t
+dll.vec_env_get_count_observations.argtypes = []
+dll.vec_env_reset.restype = None
+dll.vec_env_reset.argtypes = [ctypes.c_void_p, c_double_p]
+dll.vec_env_step.restype = None
+dll.vec_env_step.argtypes = [ctypes.c_void_p, c_double_p, c_double_p, c_double_p, c_uint8_p, c_double_p]
+dll.vec_env_set_start.restype = None
+dll.vec_env_set_start.argtypes = [ctypes.c_void_p, ctypes.c_size_t, c_double_p, c_double_p, c_double_p]
+
+RUDDER_ANGLE = 0
+THRUST = 1
+
+NOT_DONE = 0
+ARRIVED = 1
+TIME_LIMIT = 2
+
+
+def _check_error_throw_exception():
+    error_msg = dll.vec_env_get_error_msg()
+    if error_msg != None:
+        raise ValueError(error_msg.decode("utf-8"))
+
+
+def _as_c_array(array, shape):
+    '''
+    Returns the array as a contiguous float64 array of the given shape, without a copy if it is one already.
+    '''
+    array = np.ascontiguousarray(array, dtype=np.float64)
+    if array.shape != shape:
+        raise ValueError("Expected an array of shape {}, got {}.".format(shape, array.shape))
+    return array
+
+
+class Vec_env:
+    '''
+    Vectorised reinforcement learning environment of wave gliders steering to waypoints. See ASVLite/vec_env.h for the
+    observations, rewards and done flags.
+
+    The arrays returned by reset() and step() are allocated once and overwritten in place by the simulator at the
+    next call; copy them to keep them.
+    '''
+
+    def __init__(self, spec, sig_wave_height, wave_heading, rand_seed, count_component_waves,
+                 start_positions, start_attitudes, waypoints,
+                 action_type=RUDDER_ANGLE, action_interval=1000.0, episode_duration=600.0, arrival_radius=5.0):
+        '''
+        Create the environments.
+        :param tuple spec: Length at waterline, breadth at waterline, depth and draught of the vehicle, in meter.
+        :param float sig_wave_height: Significant wave height in meter.
+        :param float wave_heading: Predominant wave heading, in radians, with respect to the geographic North.
+        :param int rand_seed: Seed for random number generator.
+        :param int count_component_waves: Number of regular component waves, an odd number greater than or equal to 9.
+        :param array start_positions: Start position of each environment, K x 3, in meter.
+        :param array start_attitudes: Start attitude of each environment, K x 3, roll, pitch and yaw w.r.t. the geographic North in radians.
+        :param array waypoints: Waypoint of each environment, K x 3, in meter.
+        :param int action_type: RUDDER_ANGLE for one rudder angle per environment, or THRUST for surge, sway and heave thrust.
+        :param float action_interval: Time for which an action is applied, in milliseconds.
+        :param float episode_duration: Longest duration of an episode, in seconds.
+        :param float arrival_radius: Distance to the waypoint at which an episode ends, in meter.
+        '''
+        count_envs = len(start_positions)
+        start_positions = _as_c_array(start_positions, (count_envs, 3))
+        start_attitudes = _as_c_array(start_attitudes, (count_envs, 3))
+        waypoints = _as_c_array(waypoints, (count_envs, 3))
+        self.__c_base_object = dll.vec_env_new(*[ctypes.c_double(value) for value in spec],
+                                               sig_wave_height, wave_heading, rand_seed, count_component_waves,
+                                               count_envs,
+                                               start_positions.ctypes.data_as(c_double_p),
+                                               start_attitudes.ctypes.data_as(c_double_p),
+                                               waypoints.ctypes.data_as(c_double_p),
+                                               action_type, action_interval, episode_duration, arrival_radius)
+        _check_error_throw_exception()
+        self.count_envs = count_envs
+        self.count_actions = dll.vec_env_get_count_actions(self.__c_base_object)
+        self.count_observations = dll.vec_env_get_count_observations()
+        # Buffers written in place by the simulator.
+        self.observations = np.zeros((count_envs, self.count_observations))
+        self.rewards = np.zeros(count_envs)
+        self.dones = np.zeros(count_envs, dtype=np.uint8)
+        self.terminal_observations = np.zeros((count_envs, self.count_observations))
+
+    def __del__(self):
+        if getattr(self, "_Vec_env__c_base_object", None) is not None:
+            dll.vec_env_delete(self.__c_base_object)
+            self.__c_base_object = None
+
+    def reset(self):
+        '''
+        Reset every environment to its start. Returns the observations, K x count_observations.
+        '''
+        dll.vec_env_reset(self.__c_base_object, self.observations.ctypes.data_as(c_double_p))
+        _check_error_throw_exception()
+        return self.observations
+
+    def step(self, actions):
+        '''
+        Apply an action to every environment for one action interval, and reset the environments whose episode ended.
+        :param array actions: K x count_actions actions.
+        Returns the observations, rewards, done flags and terminal observations. Rows of the terminal observations
+        are written only for the environments whose episode ended.
+        '''
+        actions = _as_c_array(actions, (self.count_envs, self.count_actions))
+        dll.vec_env_step(self.__c_base_object,
+                         actions.ctypes.data_as(c_double_p),
+                         self.observations.ctypes.data_as(c_double_p),
+                         self.rewards.ctypes.data_as(c_double_p),
+                         self.dones.ctypes.data_as(c_uint8_p),
+                         self.terminal_observations.ctypes.data_as(c_double_p))
+        _check_error_throw_exception()
+        return self.observations, self.rewards, self.dones, self.terminal_observations
+
+    def set_start(self, k, position, attitude, waypoint):
+        '''
+        Set the start pose and the waypoint of environment k, from its next episode.
+        '''
+        position = _as_c_array(position, (3,))
+        attitude = _as_c_array(attitude, (3,))
+        waypoint = _as_c_array(waypoint, (3,))
+        dll.vec_env_set_start(self.__c_base_object, k,
+                              position.ctypes.data_as(c_double_p),
+                              attitude.ctypes.data_as(c_double_p),
+                              waypoint.ctypes.data_as(c_double_p))
+        _check_error_throw_exception()